@@ -168,6 +168,38 @@ typedef enum
                  /* refer to product datasheet for channel 12 availability */
 } ADC1_Channel_TypeDef;
 
+/**
+  * @brief  ADC1 scan notification, called from the interrupt with the block
+  *         just filled: the scans in their order, each one with one value
+  *         per channel, channel 0 first
+  */
+typedef void (*ADC1_ScanCallback_TypeDef)(const uint16_t* Block);
+
+/**
+  * @brief  ADC1 filter pipeline: oversampling with decimation, then moving
+  *         average, then first order IIR filter
+  */
+typedef struct
+{
+  uint8_t Oversampling;  /**< Log2 of the conversions summed in a sample, 0 (1) to 6 (64) */
+  uint8_t Decimation;    /**< Right shift of the sum, 0 to Oversampling: the result
+                              gains (Oversampling - Decimation) bits, at most 16 */
+  uint8_t AverageLength; /**< Log2 of the moving average length, 0 (none) to 4 (16) */
+  uint8_t IIRShift;      /**< IIR filter coefficient 2^-IIRShift, 0 (none) to 8 */
+} ADC1_Filter_TypeDef;
+
+/**
+  * @brief  ADC1 filter notification, called from the interrupt with each
+  *         filtered sample
+  */
+typedef void (*ADC1_FilterCallback_TypeDef)(uint16_t Value);
+
+/**
+  * @brief  ADC1 threshold event notification, called from the interrupt
+  *         when Channel leaves its window with the value converted
+  */
+typedef void (*ADC1_EventCallback_TypeDef)(ADC1_Channel_TypeDef Channel, uint16_t Value);
+
 /**
   * @}
   */
@@ -289,6 +321,29 @@ typedef enum
   */
 #define IS_ADC1_BUFFER_OK(BUFFER) ((BUFFER) <= (uint8_t)0x09)
 
+/**
+  * @brief  Macro used by the assert function to check the number of scans in a block.
+  */
+#define IS_ADC1_SCANS_OK(SCANS) ((SCANS) != (uint8_t)0x00)
+
+/**
+  * @brief  Macro used by the assert function to check the sample rate (Hz).
+  */
+#define IS_ADC1_SAMPLE_RATE_OK(RATE) ((RATE) != (uint32_t)0x00)
+
+/**
+  * @brief  Macro used by the assert function to check the filter pipeline settings.
+  */
+#define IS_ADC1_FILTER_OK(FILTER) (((FILTER)->Oversampling <= (uint8_t)6) && \
+                                   ((FILTER)->Decimation <= (FILTER)->Oversampling) && \
+                                   ((FILTER)->AverageLength <= (uint8_t)4) && \
+                                   ((FILTER)->IIRShift <= (uint8_t)8))
+
+/**
+  * @brief  Macro used by the assert function to check a threshold event window.
+  */
+#define IS_ADC1_EVENT_WINDOW_OK(LOW, HIGH) (((LOW) <= (HIGH)) && ((HIGH) <= (uint16_t)0x3FF))
+
 /**
   * @}
   */
@@ -323,6 +378,33 @@ uint16_t ADC1_GetConversionValue(void);
 void ADC1_SetHighThreshold(uint16_t Threshold);
 void ADC1_SetLowThreshold(uint16_t Threshold);
 uint16_t ADC1_GetBufferValue(uint8_t Buffer);
+#if defined (ADC1_SCAN_SUPPORT)
+void ADC1_ScanStart(ADC1_ConvMode_TypeDef ADC1_ConversionMode, ADC1_Channel_TypeDef ADC1_LastChannel,
+                    uint8_t ADC1_Scans, uint16_t* Buffer, ADC1_ScanCallback_TypeDef Callback);
+void ADC1_ScanStop(void);
+const uint16_t* ADC1_GetScanBlock(void);
+void ADC1_ScanISR(void);
+#endif /* ADC1_SCAN_SUPPORT */
+#if defined (ADC1_SAMPLE_RATE_SUPPORT)
+ErrorStatus ADC1_SampleStart(uint32_t ADC1_SampleRate, ADC1_Channel_TypeDef ADC1_LastChannel,
+                             uint8_t ADC1_Scans, uint16_t* Buffer, ADC1_ScanCallback_TypeDef Callback);
+void ADC1_SampleStop(void);
+#endif /* ADC1_SAMPLE_RATE_SUPPORT */
+#if defined (ADC1_FILTER_SUPPORT)
+void ADC1_FilterStart(ADC1_ConvMode_TypeDef ADC1_ConversionMode, ADC1_Channel_TypeDef ADC1_Channel,
+                      const ADC1_Filter_TypeDef* Filter, ADC1_FilterCallback_TypeDef Callback);
+void ADC1_FilterStop(void);
+uint16_t ADC1_GetFilterValue(void);
+void ADC1_FilterISR(void);
+#endif /* ADC1_FILTER_SUPPORT */
+#if defined (ADC1_EVENT_SUPPORT)
+void ADC1_EventWindowConfig(ADC1_Channel_TypeDef Channel, uint16_t LowThreshold, uint16_t HighThreshold);
+void ADC1_EventStart(ADC1_Channel_TypeDef ADC1_LastChannel, ADC1_EventCallback_TypeDef Callback);
+void ADC1_EventRearm(ADC1_Channel_TypeDef Channel);
+void ADC1_EventStop(void);
+uint16_t ADC1_EventWait(void);
+void ADC1_EventISR(void);
+#endif /* ADC1_EVENT_SUPPORT */
 FlagStatus ADC1_GetAWDChannelStatus(ADC1_Channel_TypeDef Channel);
 FlagStatus ADC1_GetFlagStatus(ADC1_Flag_TypeDef Flag);
 void ADC1_ClearFlag(ADC1_Flag_TypeDef Flag);
@@ -126,6 +126,31 @@ typedef enum {
   ADC2_CHANNEL_15 = (uint8_t)0x0F  /**< Analog channel 15 */
 } ADC2_Channel_TypeDef;
 
+/**
+  * @brief  ADC2 filter pipeline: oversampling with decimation, then moving
+  *         average, then first order IIR filter
+  */
+typedef struct
+{
+  uint8_t Oversampling;  /**< Log2 of the conversions summed in a sample, 0 (1) to 6 (64) */
+  uint8_t Decimation;    /**< Right shift of the sum, 0 to Oversampling: the result
+                              gains (Oversampling - Decimation) bits, at most 16 */
+  uint8_t AverageLength; /**< Log2 of the moving average length, 0 (none) to 4 (16) */
+  uint8_t IIRShift;      /**< IIR filter coefficient 2^-IIRShift, 0 (none) to 8 */
+} ADC2_Filter_TypeDef;
+
+/**
+  * @brief  ADC2 filter notification, called from the interrupt with each
+  *         filtered sample
+  */
+typedef void (*ADC2_FilterCallback_TypeDef)(uint16_t Value);
+
+/**
+  * @brief  ADC2 burst notification, called from the interrupt with the
+  *         buffer once filled
+  */
+typedef void (*ADC2_BurstCallback_TypeDef)(const uint16_t* Buffer);
+
 /**
   * @}
   */
@@ -213,6 +238,19 @@ typedef enum {
                                     ((CHANNEL) == ADC2_CHANNEL_14) || \
                                     ((CHANNEL) == ADC2_CHANNEL_15))
 
+/**
+  * @brief  Macro used by the assert function to check the filter pipeline settings.
+  */
+#define IS_ADC2_FILTER_OK(FILTER) (((FILTER)->Oversampling <= (uint8_t)6) && \
+                                   ((FILTER)->Decimation <= (FILTER)->Oversampling) && \
+                                   ((FILTER)->AverageLength <= (uint8_t)4) && \
+                                   ((FILTER)->IIRShift <= (uint8_t)8))
+
+/**
+  * @brief  Macro used by the assert function to check the number of samples of a burst.
+  */
+#define IS_ADC2_BURST_COUNT_OK(COUNT) ((COUNT) != (uint16_t)0x00)
+
 /**
   * @}
   */
@@ -246,6 +284,20 @@ FlagStatus ADC2_GetFlagStatus(void);
 void ADC2_ClearFlag(void);
 ITStatus ADC2_GetITStatus(void);
 void ADC2_ClearITPendingBit(void);
+#if defined (ADC2_FILTER_SUPPORT)
+void ADC2_FilterStart(ADC2_ConvMode_TypeDef ADC2_ConversionMode, ADC2_Channel_TypeDef ADC2_Channel,
+                      const ADC2_Filter_TypeDef* Filter, ADC2_FilterCallback_TypeDef Callback);
+void ADC2_FilterStop(void);
+uint16_t ADC2_GetFilterValue(void);
+void ADC2_FilterISR(void);
+#endif /* ADC2_FILTER_SUPPORT */
+#if defined (ADC2_BURST_SUPPORT)
+void ADC2_BurstStart(ADC2_Channel_TypeDef ADC2_Channel, uint16_t* Buffer, uint16_t Count,
+                     ADC2_BurstCallback_TypeDef Callback);
+void ADC2_BurstStop(void);
+FlagStatus ADC2_GetBurstStatus(void);
+void ADC2_BurstISR(void);
+#endif /* ADC2_BURST_SUPPORT */
 /**
   * @}
   */
@@ -37,6 +37,40 @@
 #define CAN_EXTID_SIZE ((uint32_t)0x1FFFFFFF)
 #define CAN_DLC_MAX ((uint8_t)0x08)
 
+#if defined (CAN_RX_FIFO_SUPPORT)
+/* Number of received frames buffered in RAM by CAN_RxISR(), power of two
+   between 2 and 128; may be overridden in stm8s_conf.h */
+#if !defined (CAN_RX_FIFO_SIZE)
+ #define CAN_RX_FIFO_SIZE (8)
+#endif /* CAN_RX_FIFO_SIZE */
+#endif /* CAN_RX_FIFO_SUPPORT */
+
+#if defined (CAN_TX_QUEUE_SUPPORT)
+/* Number of frames waiting in RAM for a free transmit mailbox, 1 to 32;
+   may be overridden in stm8s_conf.h */
+#if !defined (CAN_TX_QUEUE_SIZE)
+ #define CAN_TX_QUEUE_SIZE (8)
+#endif /* CAN_TX_QUEUE_SIZE */
+#endif /* CAN_TX_QUEUE_SUPPORT */
+
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+/* Number of identifier blocks CAN_FilterPlan() works on (stack usage is 9
+   bytes per block), 3 to 64; may be overridden in stm8s_conf.h */
+#if !defined (CAN_FILTER_PLAN_SIZE)
+ #define CAN_FILTER_PLAN_SIZE (12)
+#endif /* CAN_FILTER_PLAN_SIZE */
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+
+#if defined (CAN_STATISTICS_SUPPORT)
+/* Number of received identifiers tracked by the statistics, 1 to 32; may
+   be overridden in stm8s_conf.h */
+#if !defined (CAN_STATISTICS_IDS)
+ #define CAN_STATISTICS_IDS (8)
+#endif /* CAN_STATISTICS_IDS */
+/* Bus load measurement window, in bit times */
+#define CAN_LOAD_WINDOW ((uint32_t)50000)
+#endif /* CAN_STATISTICS_SUPPORT */
+
 
 /** @addtogroup CAN_Exported_Types
   * @{
@@ -319,6 +353,77 @@ typedef enum
   CAN_ErrorCode_CRCErr                = ((uint8_t)0x60),  /*!< CRC Error  */ 
   CAN_ErrorCode_SoftwareSetErr        = ((uint8_t)0x70)  /*!< Software Set Error  */ 
 }CAN_ErrorCode_TypeDef;
+
+/**
+  * @brief   CAN frame */
+typedef struct
+{
+  uint32_t Id;                /*!< Standard (11-bit) or extended (29-bit) identifier */
+  uint8_t  IDE;               /*!< Identifier type, one of @ref CAN_Id_TypeDef */
+  uint8_t  RTR;               /*!< Frame type, one of @ref CAN_RTR_TypeDef */
+  uint8_t  DLC;               /*!< Number of data bytes, 0 to 8 */
+  uint8_t  FMI;               /*!< Filter match index of a received frame */
+  uint8_t  Data[CAN_DLC_MAX]; /*!< Data bytes, DLC first ones valid */
+#if defined (CAN_STATISTICS_SUPPORT)
+  uint16_t TimeStamp;         /*!< Bit time counter at the start of a received frame */
+#endif /* CAN_STATISTICS_SUPPORT */
+}CAN_Frame_TypeDef;
+
+/**
+  * @brief   CAN identifier range accepted by the filter planner */
+typedef struct
+{
+  uint32_t       First; /*!< First identifier of the range */
+  uint32_t       Last;  /*!< Last identifier of the range, First for a single identifier */
+  CAN_Id_TypeDef IDE;   /*!< Standard or extended identifiers */
+}CAN_FilterRange_TypeDef;
+
+/**
+  * @brief   CAN filter plan status */
+typedef enum
+{
+  CAN_FilterPlanStatus_Exact   = ((uint8_t)0x00), /*!< Only the requested identifiers are accepted */
+  CAN_FilterPlanStatus_Widened = ((uint8_t)0x01)  /*!< Other identifiers are accepted too, software filtering still needed */
+}CAN_FilterPlanStatus_TypeDef;
+
+/**
+  * @brief   CAN bit timing, CAN_Init() parameters */
+typedef struct
+{
+  uint8_t                  Prescaler;    /*!< Baud rate prescaler, 1 to 64 */
+  CAN_SynJumpWidth_TypeDef SynJumpWidth; /*!< Synchronisation jump width */
+  CAN_BitSeg1_TypeDef      BitSeg1;      /*!< Bit segment 1, sample point at its end */
+  CAN_BitSeg2_TypeDef      BitSeg2;      /*!< Bit segment 2 */
+}CAN_BitTiming_TypeDef;
+
+#if defined (CAN_STATISTICS_SUPPORT)
+/**
+  * @brief   CAN statistics of a received identifier */
+typedef struct
+{
+  uint32_t Id;        /*!< Identifier */
+  uint8_t  IDE;       /*!< Identifier type, one of @ref CAN_Id_TypeDef */
+  uint16_t Count;     /*!< Frames received, saturates at 65535 */
+  uint16_t Period;    /*!< Mean time between two frames, in bit times */
+  uint16_t Jitter;    /*!< Mean deviation of the time between two frames from Period, in bit times */
+  uint16_t TimeStamp; /*!< Time stamp of the last frame */
+}CAN_IdStatistics_TypeDef;
+
+/**
+  * @brief   CAN bus statistics */
+typedef struct
+{
+  uint32_t RxFrames;       /*!< Frames received */
+  uint32_t TxFrames;       /*!< Frames transmitted */
+  uint16_t OtherFrames;    /*!< Frames received with an identifier not tracked, saturates at 65535 */
+  uint16_t Errors[6];      /*!< Errors by code, CAN_ErrorCode_StuffErr to CAN_ErrorCode_CRCErr, saturate at 65535 */
+  uint8_t  TxErrorCounter; /*!< Transmit error counter */
+  uint8_t  RxErrorCounter; /*!< Receive error counter */
+  uint8_t  Load;           /*!< Bus load over the last CAN_LOAD_WINDOW bit times, in percent */
+  uint8_t  IdCount;        /*!< Identifiers tracked, in the order of their first frame */
+  CAN_IdStatistics_TypeDef Ids[CAN_STATISTICS_IDS]; /*!< Received identifiers */
+}CAN_Statistics_TypeDef;
+#endif /* CAN_STATISTICS_SUPPORT */
 /**
   * @}
   */
@@ -454,6 +559,37 @@ typedef enum
   * @brief  Macro used by the assert function in order to check the Last Error Code.
   */
 #define IS_CAN_LAST_ERROR_CODE_OK(CODE)  (((CODE) & 0x8F) == 0x00)
+/**
+  * @brief  Macro used by the preprocessor to check the size of a frame ring (no cast allowed).
+  */
+#define IS_CAN_FIFO_SIZE_OK(SIZE) \
+  (((SIZE) >= 2) && ((SIZE) <= 128) && (((SIZE) & ((SIZE) - 1)) == 0))
+/**
+  * @brief  Macro used by the preprocessor to check the size of the transmit queue (no cast allowed).
+  */
+#define IS_CAN_TX_QUEUE_SIZE_OK(SIZE) (((SIZE) >= 1) && ((SIZE) <= 32))
+/**
+  * @brief  Macro used by the preprocessor to check the size of the filter planner work list (no cast allowed).
+  */
+#define IS_CAN_FILTER_PLAN_SIZE_OK(SIZE) (((SIZE) >= 3) && ((SIZE) <= 64))
+/**
+  * @brief  Macro used by the assert function in order to check the bit rate.
+  */
+#define IS_CAN_BITRATE_OK(BITRATE) (((BITRATE) >= (uint32_t)1000) && ((BITRATE) <= (uint32_t)1000000))
+/**
+  * @brief  Macro used by the assert function in order to check the sample point (per mille of the bit).
+  */
+#define IS_CAN_SAMPLE_POINT_OK(POINT) (((POINT) >= (uint16_t)500) && ((POINT) <= (uint16_t)900))
+/**
+  * @brief  Macro used by the preprocessor to check the number of identifiers tracked (no cast allowed).
+  */
+#define IS_CAN_STATISTICS_IDS_OK(IDS) (((IDS) >= 1) && ((IDS) <= 32))
+/**
+  * @brief  Macro used by the assert function in order to check an identifier range.
+  */
+#define IS_CAN_FILTER_RANGE_OK(FIRST, LAST, IDE) (((FIRST) <= (LAST)) && \
+                                                  ((((IDE) == CAN_Id_Standard) && ((LAST) <= CAN_STDID_SIZE)) || \
+                                                   (((IDE) == CAN_Id_Extended) && ((LAST) <= CAN_EXTID_SIZE))))
 /**
   * @}
   */
@@ -512,6 +648,31 @@ FlagStatus CAN_GetFlagStatus(CAN_FLAG_TypeDef CAN_Flag);
 void CAN_ClearFlag(CAN_FLAG_TypeDef CAN_Flag);
 ITStatus CAN_GetITStatus(CAN_IT_TypeDef CAN_IT);
 void CAN_ClearITPendingBit(CAN_IT_TypeDef CAN_IT);
+#if defined (CAN_RX_FIFO_SUPPORT)
+void CAN_RxFIFOCmd(FunctionalState NewState);
+ErrorStatus CAN_ReadFrame(CAN_Frame_TypeDef* CAN_Frame);
+uint8_t CAN_GetRxFrameCount(void);
+uint8_t CAN_GetRxLostCount(void);
+void CAN_RxISR(void);
+#endif /* CAN_RX_FIFO_SUPPORT */
+#if defined (CAN_TX_QUEUE_SUPPORT)
+ErrorStatus CAN_TransmitFrame(const CAN_Frame_TypeDef* CAN_Frame);
+uint8_t CAN_GetTxQueueCount(void);
+void CAN_TxISR(void);
+#endif /* CAN_TX_QUEUE_SUPPORT */
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+CAN_FilterPlanStatus_TypeDef CAN_FilterPlan(const CAN_FilterRange_TypeDef* CAN_Ranges, uint8_t CAN_Count);
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+#if defined (CAN_BIT_TIMING_SUPPORT)
+ErrorStatus CAN_ComputeBitTiming(uint32_t CAN_BitRate, uint16_t CAN_SamplePoint, CAN_BitTiming_TypeDef* CAN_BitTiming);
+uint32_t CAN_AutoBaud(CAN_MasterCtrl_TypeDef CAN_MasterCtrl, const uint32_t* CAN_BitRates, uint8_t CAN_Count,
+                      uint16_t CAN_SamplePoint, uint32_t CAN_Timeout);
+#endif /* CAN_BIT_TIMING_SUPPORT */
+#if defined (CAN_STATISTICS_SUPPORT)
+void CAN_StatisticsCmd(FunctionalState NewState);
+void CAN_GetStatistics(CAN_Statistics_TypeDef* CAN_Statistics);
+void CAN_StatisticsISR(void);
+#endif /* CAN_STATISTICS_SUPPORT */
 /**
   * @}
   */
@@ -200,6 +200,13 @@ typedef enum {
   CLK_SWIMDIVIDER_OTHER = (uint8_t)0x01 /*!< SWIM clock is not divided by 2 */
 }CLK_SWIMDivider_TypeDef;
 
+/**
+   * @brief   Clock change notification, called once fMASTER or fCPU changed.
+   *          The new frequencies are given by CLK_GetClockFreq() and
+   *          CLK_GetCPUClockFreq().
+   */
+typedef void (*CLK_FreqChangeCallback_TypeDef)(void);
+
 /**
   * @}
   */
@@ -210,6 +217,15 @@ typedef enum {
   * @{
   */
 #define CLK_TIMEOUT ((uint16_t)0xFFFF) /*!< Max Timeout for the clock switch operation. */
+
+/**
+  * @brief  Maximum number of clock change callbacks.
+  * Tip: define it in your toolchain compiler preprocessor to change the
+  * number of callbacks without modifying this file.
+  */
+#if !defined (CLK_FREQ_CALLBACKS)
+ #define CLK_FREQ_CALLBACKS ((uint8_t)4)
+#endif /* CLK_FREQ_CALLBACKS */
 /**
   * @}
   */
@@ -342,6 +358,11 @@ typedef enum {
   */
 #define IS_CLK_SWIMDIVIDER_OK(SWIMDIVIDER) (((SWIMDIVIDER) == CLK_SWIMDIVIDER_2) || ((SWIMDIVIDER) == CLK_SWIMDIVIDER_OTHER))
 
+/**
+  * @brief  Macros used by the assert function in order to check the external oscillator frequency.
+  */
+#define IS_CLK_HSE_FREQ_OK(FREQ) (((FREQ) >= (uint32_t)1000000) && ((FREQ) <= (uint32_t)24000000))
+
 /**
   * @}
   */
@@ -368,6 +389,10 @@ void CLK_ClockSecuritySystemEnable(void);
 void CLK_SYSCLKEmergencyClear(void);
 void CLK_AdjustHSICalibrationValue(CLK_HSITrimValue_TypeDef CLK_HSICalibrationValue);
 uint32_t CLK_GetClockFreq(void);
+uint32_t CLK_GetCPUClockFreq(void);
+void CLK_UpdateClockFreq(void);
+void CLK_HSEFreqConfig(uint32_t HSEFreq);
+ErrorStatus CLK_FreqChangeCallbackCmd(CLK_FreqChangeCallback_TypeDef Callback, FunctionalState NewState);
 CLK_Source_TypeDef CLK_GetSYSCLKSource(void);
 FlagStatus CLK_GetFlagStatus(CLK_Flag_TypeDef CLK_FLAG);
 ITStatus CLK_GetITStatus(CLK_IT_TypeDef CLK_IT);
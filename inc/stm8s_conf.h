@@ -32,6 +32,91 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm8s.h"
 
+/* Comment the lines below to remove the corresponding features from the UART
+   drivers and save the Flash and RAM memory they use */
+#define UART_BUFFER_SUPPORT    (1) /* Interrupt driven transmit/receive buffers */
+#define UART_LIN_SUPPORT       (1) /* LIN mode */
+#define UART_SMARTCARD_SUPPORT (1) /* Smart Card mode */
+#define UART_IRDA_SUPPORT      (1) /* IrDA mode */
+#define UART_RUNTIME_BAUDRATE_SUPPORT (1) /* UARTx_Init(): baud rate computed at run time */
+
+/* Comment the line below to remove the timeout bounded waits and the bus
+   recovery from the I2C driver (I2C_WaitEvent(), I2C_BusRecovery()) */
+#define I2C_TIMEOUT_SUPPORT    (1)
+/* Comment the line below to remove the interrupt driven master transfers
+   and the transfer queue from the I2C driver (I2C_MasterTransfer(),
+   I2C_QueueTransfer(), I2C_ISR()) */
+#define I2C_TRANSFER_SUPPORT   (1)
+/* Comment the line below to remove the slave register map emulation
+   (I2C_SlaveRegisterMapConfig(), I2C_SlaveCmd()) */
+#define I2C_SLAVE_SUPPORT      (1)
+
+/* Comment the line below to remove the block transfers from the SPI driver
+   (SPI_TransferBlock(), SPI_TransferBlockIT(), SPI_ISR(), SPI_TransferFrame()) */
+#define SPI_TRANSFER_SUPPORT   (1)
+
+/* Comment the line below to remove the RAM receive FIFO from the CAN driver
+   (CAN_RxFIFOCmd(), CAN_ReadFrame(), CAN_RxISR()) */
+#define CAN_RX_FIFO_SUPPORT    (1)
+/* Comment the line below to remove the priority ordered transmit queue from
+   the CAN driver (CAN_TransmitFrame(), CAN_TxISR()) */
+#define CAN_TX_QUEUE_SUPPORT   (1)
+/* Comment the line below to remove the acceptance filter planner from the
+   CAN driver (CAN_FilterPlan()) */
+#define CAN_FILTER_PLAN_SUPPORT (1)
+/* Comment the line below to remove the bit timing solver and the automatic
+   bit rate detection from the CAN driver (CAN_ComputeBitTiming(),
+   CAN_AutoBaud()) */
+#define CAN_BIT_TIMING_SUPPORT (1)
+/* Comment the line below to remove the time stamps and the bus statistics
+   from the CAN driver (CAN_StatisticsCmd(), CAN_GetStatistics(),
+   CAN_StatisticsISR()); they need the RAM receive FIFO */
+#define CAN_STATISTICS_SUPPORT (1)
+
+/* Comment the line below to remove the scan engine from the ADC1 driver
+   (ADC1_ScanStart(), ADC1_GetScanBlock(), ADC1_ScanISR()) */
+#define ADC1_SCAN_SUPPORT      (1)
+/* Comment the line below to remove the timer triggered sampling from the
+   ADC1 driver (ADC1_SampleStart(), ADC1_SampleStop()); it needs the scan
+   engine and the TIM1 driver (TIM5 driver on STM8S903/STM8AF622x) */
+#define ADC1_SAMPLE_RATE_SUPPORT (1)
+/* Comment the lines below to remove the oversampling and filter pipeline
+   from the ADC1 and ADC2 drivers (ADCx_FilterStart(), ADCx_GetFilterValue(),
+   ADCx_FilterISR()) */
+#define ADC1_FILTER_SUPPORT    (1)
+#define ADC2_FILTER_SUPPORT    (1)
+/* Comment the line below to remove the analog watchdog event service from
+   the ADC1 driver (ADC1_EventWindowConfig(), ADC1_EventStart(),
+   ADC1_EventWait(), ADC1_EventISR()) */
+#define ADC1_EVENT_SUPPORT     (1)
+/* Comment the line below to remove the burst acquisition from the ADC2
+   driver (ADC2_BurstStart(), ADC2_GetBurstStatus(), ADC2_BurstISR()) */
+#define ADC2_BURST_SUPPORT     (1)
+
+/* Comment the line below to leave TIM4 (TIM6 on STM8S903/STM8AF622x) to the
+   application: the system tick (TICK_Init(), TICK_GetMillis(),
+   TICK_GetMicros(), TICK_DelayMs(), TICK_ISR()) is then removed */
+#define TICK_SUPPORT           (1)
+/* Comment the line below to remove the software timer wheel advanced by the
+   system tick (TICK_TimerStart(), TICK_TimerStop(), TICK_TimerPump()) */
+#define TICK_TIMER_SUPPORT     (1)
+/* Comment the line below to remove the event scheduler (SCHED_Post(),
+   SCHED_Dispatch(), SCHED_Run()) */
+#define SCHED_SUPPORT          (1)
+/* Comment the line below to remove the interrupt priority planner from the
+   ITC driver (ITC_ApplyPlan()) */
+#define ITC_PLAN_SUPPORT       (1)
+/* Comment the line below to remove the three phase complementary PWM from
+   the TIM1 driver (TIM1_MotorPWMInit(), TIM1_MotorPWMCmd(), TIM1_SetDuty3()) */
+#define TIM1_MOTOR_PWM_SUPPORT (1)
+
+/* Uncomment the lines below to compute the baud rate registers of the UARTs
+   used at a fixed baud rate at compile time (UARTx_BRR1_VALUE and
+   UARTx_BRR2_VALUE, to be passed to UARTx_InitBRR()); no cast is allowed
+   as the values are checked by the preprocessor */
+/* #define UART_FMASTER_VALUE (16000000UL) */ /* fMASTER in Hz */
+/* #define UART1_BAUDRATE     (115200UL) */
+
 /* Uncomment the line below to enable peripheral header file inclusion */
 #if defined(STM8S105) || defined(STM8S005) || defined(STM8S103) || defined(STM8S003) ||\
     defined(STM8S903) || defined (STM8AF626x) || defined (STM8AF622x)
@@ -54,7 +139,9 @@
 #include "stm8s_itc.h"
 #include "stm8s_iwdg.h"
 #include "stm8s_rst.h"
+#include "stm8s_sched.h"
 #include "stm8s_spi.h"
+#include "stm8s_tick.h"
 #include "stm8s_tim1.h"
 #if !defined(STM8S903) || !defined(STM8AF622x)
  #include "stm8s_tim2.h"
@@ -70,6 +157,7 @@
  #include "stm8s_tim5.h"
  #include "stm8s_tim6.h"
 #endif  /* (STM8S903) || (STM8AF622x) */
+#include "stm8s_uart.h"
 #if defined(STM8S208) ||defined(STM8S207) || defined(STM8S007) ||defined(STM8S103) ||\
     defined(STM8S003) || defined(STM8S903) || defined (STM8AF52Ax) || defined (STM8AF62Ax)
  #include "stm8s_uart1.h"
@@ -324,6 +324,61 @@ typedef enum
   I2C_EVENT_SLAVE_ACK_FAILURE                = (uint16_t)0x0004  /*!< AF flag */
 } I2C_Event_TypeDef;
 
+#if defined (I2C_TIMEOUT_SUPPORT)
+/**
+  * @brief  Tick source of the I2C timeouts: returns a free running counter
+  */
+typedef uint16_t (*I2C_GetTick_TypeDef)(void);
+#endif /* I2C_TIMEOUT_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT)
+/**
+  * @brief  Status of a master transfer run by the I2C interrupt
+  */
+typedef enum
+{
+  I2C_TRANSFER_DONE   = (uint8_t)0x00, /*!< Transfer completed, STOP generated */
+  I2C_TRANSFER_BUSY   = (uint8_t)0x01, /*!< Transfer started and not yet completed */
+  I2C_TRANSFER_NACK   = (uint8_t)0x02, /*!< Address or data byte not acknowledged (AF) */
+  I2C_TRANSFER_ERROR  = (uint8_t)0x03, /*!< Bus error, arbitration lost or overrun */
+  I2C_TRANSFER_QUEUED = (uint8_t)0x04  /*!< Waiting in the transfer queue */
+} I2C_TransferStatus_TypeDef;
+
+struct I2C_Transfer_struct;
+
+/**
+  * @brief  Function called from the I2C interrupt when a transfer ends
+  */
+typedef void (*I2C_TransferCallback_TypeDef)(struct I2C_Transfer_struct* Transfer);
+
+/**
+  * @brief  Master transfer descriptor: TxLength bytes are written first, then
+  *         RxLength bytes are read after a repeated START. Either length may
+  *         be 0, both 0 only addresses the slave (presence check).
+  *         The descriptor and its buffers must stay valid until the end of
+  *         the transfer.
+  */
+typedef struct I2C_Transfer_struct
+{
+  uint8_t                      Address;  /*!< 7-bit slave address (not shifted) */
+  const uint8_t*               TxBuffer; /*!< Bytes written to the slave */
+  uint8_t                      TxLength; /*!< Number of bytes to write */
+  uint8_t*                     RxBuffer; /*!< Bytes read from the slave */
+  uint8_t                      RxLength; /*!< Number of bytes to read */
+  I2C_TransferCallback_TypeDef Callback; /*!< Called at the end of the transfer, may be 0 */
+  volatile I2C_TransferStatus_TypeDef Status; /*!< Updated by the I2C interrupt */
+}
+I2C_Transfer_TypeDef;
+#endif /* I2C_TRANSFER_SUPPORT */
+
+#if defined (I2C_SLAVE_SUPPORT)
+/**
+  * @brief  Function called from the I2C interrupt at the end of a host write
+  *         to the slave register map
+  */
+typedef void (*I2C_SlaveCallback_TypeDef)(uint8_t Register, uint8_t Count);
+#endif /* I2C_SLAVE_SUPPORT */
+
 /**
   * @}
   */
@@ -340,6 +395,37 @@ typedef enum
  #define I2C_MAX_INPUT_FREQ     ((uint8_t)16)
 #endif
 
+#if defined (I2C_TIMEOUT_SUPPORT)
+/* Timeout of the I2C waits until I2C_TimeoutConfig() is called, in polling
+   loops as no tick source is set by default */
+#define I2C_DEFAULT_TIMEOUT ((uint16_t)10000)
+
+/* GPIO pins of the I2C, driven by I2C_BusRecovery(); may be overridden in
+   stm8s_conf.h */
+#if !defined (I2C_SCL_GPIO_PORT)
+ #if defined(STM8S208) || defined(STM8S207) || defined(STM8S007) || defined(STM8S105) || \
+     defined(STM8S005) || defined(STM8AF52Ax) || defined(STM8AF62Ax) || defined(STM8AF626x)
+  #define I2C_SCL_GPIO_PORT (GPIOE)
+  #define I2C_SCL_GPIO_PIN  (GPIO_PIN_1)
+  #define I2C_SDA_GPIO_PORT (GPIOE)
+  #define I2C_SDA_GPIO_PIN  (GPIO_PIN_2)
+ #else
+  #define I2C_SCL_GPIO_PORT (GPIOB)
+  #define I2C_SCL_GPIO_PIN  (GPIO_PIN_4)
+  #define I2C_SDA_GPIO_PORT (GPIOB)
+  #define I2C_SDA_GPIO_PIN  (GPIO_PIN_5)
+ #endif
+#endif /* I2C_SCL_GPIO_PORT */
+#endif /* I2C_TIMEOUT_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT)
+/* Number of transfers waiting behind the one in progress, power of two
+   between 2 and 128; may be overridden in stm8s_conf.h */
+#if !defined (I2C_TRANSFER_QUEUE_SIZE)
+ #define I2C_TRANSFER_QUEUE_SIZE (4)
+#endif /* I2C_TRANSFER_QUEUE_SIZE */
+#endif /* I2C_TRANSFER_SUPPORT */
+
 /**
   *@}
   */
@@ -493,6 +579,22 @@ typedef enum
 #define IS_I2C_OUTPUT_CLOCK_FREQ_OK(FREQ) \
   (((FREQ) >= (uint8_t)1) && ((FREQ) <= I2C_MAX_FAST_FREQ))
 
+/**
+  * @brief   Macro used by the assert function to check the 7-bit slave address of a transfer.
+  */
+#define IS_I2C_TRANSFER_ADDRESS_OK(ADDRESS) ((ADDRESS) <= (uint8_t)0x7F)
+
+/**
+  * @brief   Macro used by the assert function to check the size of the slave register map.
+  */
+#define IS_I2C_SLAVE_MAP_SIZE_OK(SIZE) ((SIZE) != (uint8_t)0)
+
+/**
+  * @brief   Macro used by the preprocessor to check the transfer queue size (no cast allowed).
+  */
+#define IS_I2C_TRANSFER_QUEUE_SIZE_OK(SIZE) \
+  (((SIZE) >= 2) && ((SIZE) <= 128) && (((SIZE) & ((SIZE) - 1)) == 0))
+
 /**
   * @}
   */
@@ -621,6 +723,44 @@ void I2C_ClearFlag(I2C_Flag_TypeDef I2C_FLAG);
 ITStatus I2C_GetITStatus(I2C_ITPendingBit_TypeDef I2C_ITPendingBit);
 void I2C_ClearITPendingBit(I2C_ITPendingBit_TypeDef I2C_ITPendingBit);
 
+#if defined (I2C_TIMEOUT_SUPPORT)
+/**
+ *
+ *  Timeout bounded waits and bus recovery
+ *******************************************************************************
+ */
+void I2C_TimeoutConfig(I2C_GetTick_TypeDef GetTick, uint16_t Timeout);
+ErrorStatus I2C_WaitEvent(I2C_Event_TypeDef I2C_Event);
+ErrorStatus I2C_WaitFlagStatus(I2C_Flag_TypeDef I2C_Flag, FlagStatus Status);
+ErrorStatus I2C_BusRecovery(void);
+#endif /* I2C_TIMEOUT_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT)
+/**
+ *
+ *  Interrupt driven master transfers
+ *******************************************************************************
+ */
+ErrorStatus I2C_MasterTransfer(I2C_Transfer_TypeDef* Transfer);
+ErrorStatus I2C_QueueTransfer(I2C_Transfer_TypeDef* Transfer);
+FlagStatus I2C_GetTransferBusy(void);
+#endif /* I2C_TRANSFER_SUPPORT */
+
+#if defined (I2C_SLAVE_SUPPORT)
+/**
+ *
+ *  Interrupt driven slave register map
+ *******************************************************************************
+ */
+void I2C_SlaveRegisterMapConfig(uint8_t* Map, const uint8_t* WriteMask,
+                                uint8_t Size, I2C_SlaveCallback_TypeDef Callback);
+void I2C_SlaveCmd(FunctionalState NewState);
+#endif /* I2C_SLAVE_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT) || defined (I2C_SLAVE_SUPPORT)
+void I2C_ISR(void);
+#endif /* I2C_TRANSFER_SUPPORT || I2C_SLAVE_SUPPORT */
+
 
 /**
   * @}
@@ -124,6 +124,15 @@ typedef enum {
   ITC_PRIORITYLEVEL_3 = (uint8_t)0x03  /*!< Software priority level 3 */
 } ITC_PriorityLevel_TypeDef;
 
+/**
+  * @brief  Interrupt source of a priority plan, with its latency budget
+  */
+typedef struct
+{
+  ITC_Irq_TypeDef Irq; /*!< Interrupt source */
+  uint16_t Budget;     /*!< Worst case latency allowed, in any unit common to the plan */
+} ITC_Plan_TypeDef;
+
 /**
   * @}
   */
@@ -160,6 +169,15 @@ typedef enum {
 /* Used by assert function */
 #define IS_ITC_INTERRUPTS_DISABLED (ITC_GetSoftIntStatus() == CPU_SOFT_INT_DISABLED)
 
+/* Used by assert function */
+#define IS_ITC_PLAN_COUNT_OK(COUNT) ((COUNT) <= (uint8_t)25)
+
+/* Used by assert function */
+#define IS_ITC_RAISE_LEVEL_OK(LEVEL) \
+  (((LEVEL) == ITC_PRIORITYLEVEL_1) || \
+   ((LEVEL) == ITC_PRIORITYLEVEL_2) || \
+   ((LEVEL) == ITC_PRIORITYLEVEL_3))
+
 /**
   * @}
   */
@@ -175,6 +193,12 @@ void ITC_DeInit(void);
 uint8_t ITC_GetSoftIntStatus(void);
 void ITC_SetSoftwarePriority(ITC_Irq_TypeDef IrqNum, ITC_PriorityLevel_TypeDef PriorityValue);
 ITC_PriorityLevel_TypeDef ITC_GetSoftwarePriority(ITC_Irq_TypeDef IrqNum);
+void ITC_SetCPUCC(uint8_t CC);
+uint8_t ITC_RaiseLevel(ITC_PriorityLevel_TypeDef Level);
+void ITC_RestoreLevel(uint8_t SavedCC);
+#if defined (ITC_PLAN_SUPPORT)
+void ITC_ApplyPlan(const ITC_Plan_TypeDef* Plan, uint8_t Count);
+#endif /* ITC_PLAN_SUPPORT */
 
 /**
   * @}
@@ -0,0 +1,120 @@
+/**
+  ********************************************************************************
+  * @file    stm8s_sched.h
+  * @author  MCD Application Team
+  * @version V2.2.0
+  * @date    30-September-2014
+  * @brief   This file contains all functions prototypes and macros for the
+  *          cooperative run to completion event scheduler.
+   ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM8S_SCHED_H
+#define __STM8S_SCHED_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm8s.h"
+
+/** @addtogroup STM8S_StdPeriph_Driver
+  * @{
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/** @addtogroup SCHED_Exported_Types
+  * @{
+  */
+
+/**
+  * @brief  Event handler, run to completion from the main loop with the
+  *         parameter posted
+  */
+typedef void (*SCHED_Handler_TypeDef)(uint8_t Param);
+
+/**
+  * @}
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+#if defined (SCHED_SUPPORT)
+/* Number of event priorities, 1 to 8, 0 being the most urgent; may be
+   overridden in stm8s_conf.h */
+#if !defined (SCHED_PRIORITIES)
+ #define SCHED_PRIORITIES (3)
+#endif /* SCHED_PRIORITIES */
+/* Events queued per priority, a power of two from 2 to 128 (3 bytes of RAM
+   per event); may be overridden in stm8s_conf.h */
+#if !defined (SCHED_QUEUE_SIZE)
+ #define SCHED_QUEUE_SIZE (8)
+#endif /* SCHED_QUEUE_SIZE */
+#endif /* SCHED_SUPPORT */
+
+/* Exported macros -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+
+/** @addtogroup SCHED_Private_Macros
+  * @{
+  */
+
+/**
+  * @brief  Macro used by the preprocessor to check the number of priorities.
+  */
+#define IS_SCHED_PRIORITIES_OK(COUNT) (((COUNT) >= 1) && ((COUNT) <= 8))
+
+/**
+  * @brief  Macro used by the preprocessor to check the queue size.
+  */
+#define IS_SCHED_QUEUE_SIZE_OK(SIZE) (((SIZE) >= 2) && ((SIZE) <= 128) && \
+                                      (((SIZE) & ((SIZE) - 1)) == 0))
+
+/**
+  * @brief  Macro used by the assert function to check an event priority.
+  */
+#define IS_SCHED_PRIORITY_OK(PRIORITY) ((PRIORITY) < (uint8_t)SCHED_PRIORITIES)
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/** @addtogroup SCHED_Exported_Functions
+  * @{
+  */
+#if defined (SCHED_SUPPORT)
+void SCHED_Init(void);
+ErrorStatus SCHED_Post(uint8_t Priority, SCHED_Handler_TypeDef Handler, uint8_t Param);
+bool SCHED_Dispatch(void);
+void SCHED_Run(void);
+#endif /* SCHED_SUPPORT */
+
+/**
+  * @}
+  */
+
+#endif /* __STM8S_SCHED_H */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
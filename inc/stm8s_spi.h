@@ -160,6 +160,30 @@ typedef enum
   SPI_IT_ERR    = (uint8_t)0x05   /*!< Error interrupt*/
 } SPI_IT_TypeDef;
 
+#if defined (SPI_TRANSFER_SUPPORT)
+/**
+  * @brief  Function called from the SPI interrupt at the end of a block
+  *         transfer, with ERROR if a received byte was lost (overrun)
+  */
+typedef void (*SPI_TransferCallback_TypeDef)(ErrorStatus Status);
+#endif /* SPI_TRANSFER_SUPPORT */
+
+/**
+  * @}
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @addtogroup SPI_Exported_Constants
+  * @{
+  */
+#if defined (SPI_TRANSFER_SUPPORT)
+/* Byte sent by the block transfers when no transmit buffer is given */
+#if !defined (SPI_DUMMY_BYTE)
+ #define SPI_DUMMY_BYTE ((uint8_t)0xFF)
+#endif /* SPI_DUMMY_BYTE */
+#endif /* SPI_TRANSFER_SUPPORT */
+
 /**
   * @}
   */
@@ -292,6 +316,12 @@ typedef enum
 #define IS_SPI_CLEAR_IT_OK(ITPendingBit) (((ITPendingBit) == SPI_IT_CRCERR) || \
     ((ITPendingBit) == SPI_IT_WKUP))
 
+/**
+  * @brief  Macro used by the assert_param function in order to check the
+  *         length of an interrupt driven block transfer
+  */
+#define IS_SPI_TRANSFER_LENGTH_OK(LENGTH) ((LENGTH) != (uint16_t)0)
+
 /**
   * @}
   */
@@ -321,6 +351,14 @@ FlagStatus SPI_GetFlagStatus(SPI_Flag_TypeDef SPI_FLAG);
 void SPI_ClearFlag(SPI_Flag_TypeDef SPI_FLAG);
 ITStatus SPI_GetITStatus(SPI_IT_TypeDef SPI_IT);
 void SPI_ClearITPendingBit(SPI_IT_TypeDef SPI_IT);
+#if defined (SPI_TRANSFER_SUPPORT)
+void SPI_TransferBlock(const uint8_t* TxBuffer, uint8_t* RxBuffer, uint16_t Length);
+ErrorStatus SPI_TransferBlockIT(const uint8_t* TxBuffer, uint8_t* RxBuffer, uint16_t Length,
+                                SPI_TransferCallback_TypeDef Callback);
+FlagStatus SPI_GetTransferBusy(void);
+void SPI_ISR(void);
+ErrorStatus SPI_TransferFrame(const uint8_t* TxBuffer, uint8_t* RxBuffer, uint16_t Length);
+#endif /* SPI_TRANSFER_SUPPORT */
 
 /**
   * @}
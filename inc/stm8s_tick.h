@@ -0,0 +1,154 @@
+/**
+  ********************************************************************************
+  * @file    stm8s_tick.h
+  * @author  MCD Application Team
+  * @version V2.2.0
+  * @date    30-September-2014
+  * @brief   This file contains all functions prototypes and macros for the
+  *          system tick built on TIM4 (TIM6 on STM8S903/STM8AF622x).
+   ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM8S_TICK_H
+#define __STM8S_TICK_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm8s.h"
+
+/** @addtogroup STM8S_StdPeriph_Driver
+  * @{
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+#if defined (TICK_TIMER_SUPPORT)
+/** @addtogroup TICK_Exported_Types
+  * @{
+  */
+
+/**
+  * @brief  Context in which a software timer calls back
+  */
+typedef enum
+{
+  TICK_TIMER_ISR      = (uint8_t)0x00, /*!< From the tick interrupt */
+  TICK_TIMER_DEFERRED = (uint8_t)0x01  /*!< From TICK_TimerPump() in the main loop */
+} TICK_TimerMode_TypeDef;
+
+struct TICK_Timer_struct;
+
+/**
+  * @brief  Software timer notification, with the timer which expired
+  */
+typedef void (*TICK_TimerCallback_TypeDef)(struct TICK_Timer_struct* Timer);
+
+/**
+  * @brief  Software timer, allocated by the application; it may be embedded
+  *         in a larger structure holding the callback context.
+  */
+typedef struct TICK_Timer_struct
+{
+  struct TICK_Timer_struct* Next;      /*!< Timers of the same wheel slot */
+  struct TICK_Timer_struct* Prev;
+  struct TICK_Timer_struct* Link;      /*!< Timers waiting for their callback */
+  uint32_t Expiry;                     /*!< TICK_GetMillis() value at expiry */
+  uint32_t Period;                     /*!< Reload in ms, 0 for a one-shot timer */
+  TICK_TimerCallback_TypeDef Callback;
+  uint8_t Mode;                        /*!< TICK_TimerMode_TypeDef */
+  uint8_t Armed;                       /*!< In the wheel */
+  uint8_t Pending;                     /*!< Callback due (1), cancelled (2) or none (0) */
+} TICK_Timer_TypeDef;
+
+/**
+  * @}
+  */
+#endif /* TICK_TIMER_SUPPORT */
+
+/* Exported constants --------------------------------------------------------*/
+
+#if defined (TICK_TIMER_SUPPORT)
+/* Number of slots of the timer wheel, a power of two from 2 to 128 (2 bytes
+   of RAM per slot); may be overridden in stm8s_conf.h */
+#if !defined (TICK_WHEEL_SIZE)
+ #define TICK_WHEEL_SIZE (16)
+#endif /* TICK_WHEEL_SIZE */
+#endif /* TICK_TIMER_SUPPORT */
+
+/* Exported macros -----------------------------------------------------------*/
+
+/** @addtogroup TICK_Exported_Macros
+  * @{
+  */
+
+/**
+  * @brief  Wrap safe check that Duration ms (or us) elapsed since Start,
+  *         a value returned by TICK_GetMillis() (or TICK_GetMicros()).
+  */
+#define TICK_ELAPSED(NOW, START, DURATION) ((uint32_t)((NOW) - (START)) >= (uint32_t)(DURATION))
+
+/**
+  * @brief  Macro used by the preprocessor to check the timer wheel size.
+  */
+#define IS_TICK_WHEEL_SIZE_OK(SIZE) (((SIZE) >= 2) && ((SIZE) <= 128) && \
+                                     (((SIZE) & ((SIZE) - 1)) == 0))
+
+/**
+  * @brief  Macro used by the assert function to check the timer mode.
+  */
+#define IS_TICK_TIMER_MODE_OK(MODE) (((MODE) == TICK_TIMER_ISR) || \
+                                     ((MODE) == TICK_TIMER_DEFERRED))
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/** @addtogroup TICK_Exported_Functions
+  * @{
+  */
+#if defined (TICK_SUPPORT)
+ErrorStatus TICK_Init(void);
+uint32_t TICK_GetMillis(void);
+uint32_t TICK_GetMicros(void);
+bool TICK_Expired(uint32_t Start, uint32_t Duration);
+void TICK_DelayMs(uint32_t Duration);
+void TICK_ISR(void);
+#endif /* TICK_SUPPORT */
+#if defined (TICK_TIMER_SUPPORT)
+void TICK_TimerInit(TICK_Timer_TypeDef* Timer, TICK_TimerMode_TypeDef Mode,
+                    TICK_TimerCallback_TypeDef Callback);
+void TICK_TimerStart(TICK_Timer_TypeDef* Timer, uint32_t Delay, uint32_t Period);
+void TICK_TimerStop(TICK_Timer_TypeDef* Timer);
+uint8_t TICK_TimerPump(void);
+#endif /* TICK_TIMER_SUPPORT */
+
+/**
+  * @}
+  */
+
+#endif /* __STM8S_TICK_H */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
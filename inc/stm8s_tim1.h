@@ -470,6 +470,11 @@ typedef enum
 
 #define IS_TIM1_CLEAR_FLAG_OK(FLAG) ((((uint16_t)(FLAG) & (uint16_t)0xE100) == 0x0000) && ((FLAG) != 0x0000))
 
+/**
+  * @brief  Macro used by the assert function in order to check the motor PWM period.
+  */
+#define IS_TIM1_MOTOR_PERIOD_OK(PERIOD) ((PERIOD) != (uint16_t)0x0000)
+
 /** TIM1 Forced Action */
 typedef enum
 {
@@ -594,6 +599,12 @@ void TIM1_SetCompare1(uint16_t Compare1);
 void TIM1_SetCompare2(uint16_t Compare2);
 void TIM1_SetCompare3(uint16_t Compare3);
 void TIM1_SetCompare4(uint16_t Compare4);
+#if defined (TIM1_MOTOR_PWM_SUPPORT)
+void TIM1_MotorPWMInit(uint16_t TIM1_Prescaler, uint16_t TIM1_Period, uint8_t TIM1_DeadTime,
+                       TIM1_BreakState_TypeDef TIM1_Break, TIM1_BreakPolarity_TypeDef TIM1_BreakPolarity);
+void TIM1_MotorPWMCmd(FunctionalState NewState);
+void TIM1_SetDuty3(uint16_t Duty1, uint16_t Duty2, uint16_t Duty3);
+#endif /* TIM1_MOTOR_PWM_SUPPORT */
 void TIM1_SetIC1Prescaler(TIM1_ICPSC_TypeDef TIM1_IC1Prescaler);
 void TIM1_SetIC2Prescaler(TIM1_ICPSC_TypeDef TIM1_IC2Prescaler);
 void TIM1_SetIC3Prescaler(TIM1_ICPSC_TypeDef TIM1_IC3Prescaler);
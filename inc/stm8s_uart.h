@@ -0,0 +1,354 @@
+/**
+  ********************************************************************************
+  * @file    stm8s_uart.h
+  * @author  MCD Application Team
+  * @version V2.2.0
+  * @date    30-September-2014
+  * @brief   This file contains all functions prototypes and macros for the UART
+  *          core shared by the UART1, UART2, UART3 and UART4 drivers.
+   ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM8S_UART_H
+#define __STM8S_UART_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm8s.h"
+
+/** @addtogroup STM8S_StdPeriph_Driver
+  * @{
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/** @addtogroup UART_Exported_Types
+  * @{
+  */
+
+/**
+  * @brief  Register block common to all the UART instances.
+  * @note   The UARTx drivers pass their base address to the core functions.
+  *         The features available on each instance are:
+  *         - UART1: SmartCard, IrDA, Half Duplex, LIN master (no CR6)
+  *         - UART2: SmartCard, IrDA, LIN master/slave
+  *         - UART3: LIN master/slave (no CR5, no synchronous mode)
+  *         - UART4: SmartCard, IrDA, Half Duplex, LIN master/slave
+  */
+typedef struct UART_struct
+{
+  __IO uint8_t SR;   /*!< status register */
+  __IO uint8_t DR;   /*!< data register */
+  __IO uint8_t BRR1; /*!< baud rate register */
+  __IO uint8_t BRR2; /*!< DIV mantissa[11:8] SCIDIV fraction */
+  __IO uint8_t CR1;  /*!< control register 1 */
+  __IO uint8_t CR2;  /*!< control register 2 */
+  __IO uint8_t CR3;  /*!< control register 3 */
+  __IO uint8_t CR4;  /*!< control register 4 */
+  __IO uint8_t CR5;  /*!< control register 5 (not on UART3) */
+  __IO uint8_t CR6;  /*!< control register 6 (not on UART1) */
+}
+UART_TypeDef;
+
+#if defined (UART_BUFFER_SUPPORT)
+/**
+  * @brief  Interrupt driven transmit/receive buffers of one UART instance.
+  * @note   The head index is only written by the producer and the tail index
+  *         only by the consumer; both are free running 8-bit counters masked
+  *         on access so that their difference is the number of stored bytes.
+  *         Each side reads the other index with a single byte load, hence no
+  *         interrupt masking is needed.
+  */
+typedef struct
+{
+  UART_TypeDef*    UARTx;    /*!< Register block of the UART instance */
+  uint8_t*         TxBuffer; /*!< Transmit ring storage */
+  uint8_t*         RxBuffer; /*!< Receive ring storage */
+  uint8_t          TxMask;   /*!< Transmit ring size minus one */
+  uint8_t          RxMask;   /*!< Receive ring size minus one */
+  volatile uint8_t TxHead;   /*!< Written by UART_Write() */
+  volatile uint8_t TxTail;   /*!< Written by UART_TxISR() */
+  volatile uint8_t RxHead;   /*!< Written by UART_RxISR() */
+  volatile uint8_t RxTail;   /*!< Written by UART_Read() */
+}
+UART_Buffer_TypeDef;
+#endif /* UART_BUFFER_SUPPORT */
+
+/**
+  * @}
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @addtogroup UART_Exported_Constants
+  * @{
+  */
+
+#if defined (UART1)
+ #define UART1_CORE ((UART_TypeDef *) UART1_BaseAddress)
+#endif /* UART1 */
+#if defined (UART2)
+ #define UART2_CORE ((UART_TypeDef *) UART2_BaseAddress)
+#endif /* UART2 */
+#if defined (UART3)
+ #define UART3_CORE ((UART_TypeDef *) UART3_BaseAddress)
+#endif /* UART3 */
+#if defined (UART4)
+ #define UART4_CORE ((UART_TypeDef *) UART4_BaseAddress)
+#endif /* UART4 */
+
+/* LIN slave mode (CR6 register) is only present on UART2, UART3 and UART4 */
+#if defined (UART2) || defined (UART3) || defined (UART4)
+ #define UART_CR6_PRESENT
+#endif /* UART2 || UART3 || UART4 */
+
+/**
+  * @brief  SyncMode value for the instances without synchronous mode: the
+  *         clock bits of CR3 are left untouched by UART_Init().
+  */
+#define UART_SYNCMODE_NONE ((uint8_t)0x00)
+
+#define UART_SYNCMODE_CLOCK_DISABLE ((uint8_t)0x80) /*!< SyncMode clock disable request */
+#define UART_MODE_RX_ENABLE         ((uint8_t)0x08) /*!< Mode receive enable request */
+#define UART_MODE_TX_ENABLE         ((uint8_t)0x04) /*!< Mode transmit enable request */
+
+#define UART_SR_TXE       ((uint8_t)0x80) /*!< Transmit Data Register Empty mask */
+#define UART_SR_RXNE      ((uint8_t)0x20) /*!< Read Data Register Not Empty mask */
+
+#define UART_BRR1_DIVM    ((uint8_t)0xFF) /*!< LSB mantissa of UARTDIV [7:0] mask */
+#define UART_BRR2_DIVM    ((uint8_t)0xF0) /*!< MSB mantissa of UARTDIV [11:8] mask */
+#define UART_BRR2_DIVF    ((uint8_t)0x0F) /*!< Fraction bits of UARTDIV [3:0] mask */
+
+#define UART_CR1_R8       ((uint8_t)0x80) /*!< Receive Data bit 8 */
+#define UART_CR1_T8       ((uint8_t)0x40) /*!< Transmit data bit 8 */
+#define UART_CR1_UARTD    ((uint8_t)0x20) /*!< UART Disable (for low power consumption) */
+#define UART_CR1_M        ((uint8_t)0x10) /*!< Word length mask */
+#define UART_CR1_WAKE     ((uint8_t)0x08) /*!< Wake-up method mask */
+#define UART_CR1_PCEN     ((uint8_t)0x04) /*!< Parity Control Enable mask */
+#define UART_CR1_PS       ((uint8_t)0x02) /*!< Parity Selection */
+
+#define UART_CR2_TIEN     ((uint8_t)0x80) /*!< Transmitter Interrupt Enable mask */
+#define UART_CR2_RIEN     ((uint8_t)0x20) /*!< Receiver Interrupt Enable mask */
+#define UART_CR2_TEN      ((uint8_t)0x08) /*!< Transmitter Enable mask */
+#define UART_CR2_REN      ((uint8_t)0x04) /*!< Receiver Enable mask */
+#define UART_CR2_RWU      ((uint8_t)0x02) /*!< Receiver Wake-Up mask */
+#define UART_CR2_SBK      ((uint8_t)0x01) /*!< Send Break mask */
+
+#define UART_CR3_LINEN    ((uint8_t)0x40) /*!< LIN mode enable mask */
+#define UART_CR3_STOP     ((uint8_t)0x30) /*!< STOP bits [1:0] mask */
+#define UART_CR3_CKEN     ((uint8_t)0x08) /*!< Clock Enable mask */
+#define UART_CR3_CPOL     ((uint8_t)0x04) /*!< Clock Polarity mask */
+#define UART_CR3_CPHA     ((uint8_t)0x02) /*!< Clock Phase mask */
+#define UART_CR3_LBCL     ((uint8_t)0x01) /*!< Last Bit Clock pulse mask */
+
+#define UART_CR4_LBDL     ((uint8_t)0x20) /*!< LIN Break Detection Length mask */
+#define UART_CR4_LBDF     ((uint8_t)0x10) /*!< LIN Break Detection Flag mask */
+#define UART_CR4_ADD      ((uint8_t)0x0F) /*!< Address of the UART node mask */
+
+#define UART_CR5_SCEN     ((uint8_t)0x20) /*!< Smart Card Enable mask */
+#define UART_CR5_NACK     ((uint8_t)0x10) /*!< Smart Card Nack Enable mask */
+#define UART_CR5_HDSEL    ((uint8_t)0x08) /*!< Half-Duplex Selection mask */
+#define UART_CR5_IRLP     ((uint8_t)0x04) /*!< Irda Low Power Selection mask */
+#define UART_CR5_IREN     ((uint8_t)0x02) /*!< Irda Enable mask */
+
+#define UART_CR6_LDUM     ((uint8_t)0x80) /*!< LIN Divider Update Method */
+#define UART_CR6_LSLV     ((uint8_t)0x20) /*!< LIN Slave Enable */
+#define UART_CR6_LASE     ((uint8_t)0x10) /*!< LIN Auto synchronization Enable */
+
+/**
+  * @}
+  */
+
+/* Exported macros ------------------------------------------------------------*/
+
+/** @addtogroup UART_Exported_Macros
+  * @{
+  */
+
+/**
+  * @brief  Checks at compile time that a buffer size is a power of two
+  *         between 2 and 128.
+  */
+#define IS_UART_BUFFER_SIZE_OK(SIZE) \
+  ((((SIZE) & ((SIZE) - 1)) == 0) && ((SIZE) >= 2) && ((SIZE) <= 128))
+
+/**
+  * @brief  UART divider UARTDIV = fMASTER / BaudRate, rounded to the nearest
+  *         integer.
+  * @note   The UART macros below contain no cast so that they can also be
+  *         evaluated by the preprocessor when both arguments are constants.
+  */
+#define UART_BRR_DIV(FMASTER, BAUD) (((FMASTER) + ((BAUD) / 2)) / (BAUD))
+
+/**
+  * @brief  BRR1 register value: UARTDIV[11:4].
+  */
+#define UART_BRR1_FROM(FMASTER, BAUD) \
+  ((UART_BRR_DIV((FMASTER), (BAUD)) >> 4) & 0xFF)
+
+/**
+  * @brief  BRR2 register value: UARTDIV[15:12] in the high nibble and
+  *         UARTDIV[3:0] in the low nibble.
+  */
+#define UART_BRR2_FROM(FMASTER, BAUD) \
+  (((UART_BRR_DIV((FMASTER), (BAUD)) >> 8) & 0xF0) | \
+   (UART_BRR_DIV((FMASTER), (BAUD)) & 0x0F))
+
+/**
+  * @brief  Error in per mille between the requested baud rate and the baud
+  *         rate really obtained with UART_BRR_DIV().
+  */
+#define UART_BRR_ERROR_PERMILLE(FMASTER, BAUD) \
+  ((((FMASTER) > (UART_BRR_DIV((FMASTER), (BAUD)) * (BAUD))) ? \
+    ((FMASTER) - (UART_BRR_DIV((FMASTER), (BAUD)) * (BAUD))) : \
+    ((UART_BRR_DIV((FMASTER), (BAUD)) * (BAUD)) - (FMASTER))) * 1000 / \
+   (UART_BRR_DIV((FMASTER), (BAUD)) * (BAUD)))
+
+/**
+  * @brief  Checks that a baud rate can be generated from fMASTER: UARTDIV
+  *         must be in the range [16, 0xFFFF] and the baud rate error must
+  *         not exceed UART_BRR_MAX_ERROR_PERMILLE.
+  */
+#define IS_UART_BRR_OK(FMASTER, BAUD) \
+  ((UART_BRR_DIV((FMASTER), (BAUD)) >= 16) && \
+   (UART_BRR_DIV((FMASTER), (BAUD)) <= 0xFFFF) && \
+   (UART_BRR_ERROR_PERMILLE((FMASTER), (BAUD)) <= UART_BRR_MAX_ERROR_PERMILLE))
+
+/**
+  * @}
+  */
+
+/** @addtogroup UART_Exported_Constants
+  * @{
+  */
+
+/**
+  * @brief  Highest baud rate error in per mille accepted at build time.
+  */
+#if !defined (UART_BRR_MAX_ERROR_PERMILLE)
+ #define UART_BRR_MAX_ERROR_PERMILLE (20)
+#endif /* UART_BRR_MAX_ERROR_PERMILLE */
+
+/**
+  * @brief  Fixed baud rate register values.
+  * @note   When fMASTER (UART_FMASTER_VALUE, in Hz) and the baud rate of an
+  *         instance (UARTx_BAUDRATE) are defined in stm8s_conf.h or in the
+  *         toolchain compiler preprocessor, UARTx_BRR1_VALUE and
+  *         UARTx_BRR2_VALUE are computed by the preprocessor for
+  *         UARTx_InitBRR(), and the build fails when the baud rate cannot
+  *         be generated within UART_BRR_MAX_ERROR_PERMILLE.
+  */
+#if defined (UART_FMASTER_VALUE)
+#if defined (UART1_BAUDRATE)
+ #if !IS_UART_BRR_OK(UART_FMASTER_VALUE, UART1_BAUDRATE)
+  #error "UART1_BAUDRATE cannot be generated from UART_FMASTER_VALUE"
+ #endif
+ #define UART1_BRR1_VALUE ((uint8_t)UART_BRR1_FROM(UART_FMASTER_VALUE, UART1_BAUDRATE))
+ #define UART1_BRR2_VALUE ((uint8_t)UART_BRR2_FROM(UART_FMASTER_VALUE, UART1_BAUDRATE))
+#endif /* UART1_BAUDRATE */
+#if defined (UART2_BAUDRATE)
+ #if !IS_UART_BRR_OK(UART_FMASTER_VALUE, UART2_BAUDRATE)
+  #error "UART2_BAUDRATE cannot be generated from UART_FMASTER_VALUE"
+ #endif
+ #define UART2_BRR1_VALUE ((uint8_t)UART_BRR1_FROM(UART_FMASTER_VALUE, UART2_BAUDRATE))
+ #define UART2_BRR2_VALUE ((uint8_t)UART_BRR2_FROM(UART_FMASTER_VALUE, UART2_BAUDRATE))
+#endif /* UART2_BAUDRATE */
+#if defined (UART3_BAUDRATE)
+ #if !IS_UART_BRR_OK(UART_FMASTER_VALUE, UART3_BAUDRATE)
+  #error "UART3_BAUDRATE cannot be generated from UART_FMASTER_VALUE"
+ #endif
+ #define UART3_BRR1_VALUE ((uint8_t)UART_BRR1_FROM(UART_FMASTER_VALUE, UART3_BAUDRATE))
+ #define UART3_BRR2_VALUE ((uint8_t)UART_BRR2_FROM(UART_FMASTER_VALUE, UART3_BAUDRATE))
+#endif /* UART3_BAUDRATE */
+#if defined (UART4_BAUDRATE)
+ #if !IS_UART_BRR_OK(UART_FMASTER_VALUE, UART4_BAUDRATE)
+  #error "UART4_BAUDRATE cannot be generated from UART_FMASTER_VALUE"
+ #endif
+ #define UART4_BRR1_VALUE ((uint8_t)UART_BRR1_FROM(UART_FMASTER_VALUE, UART4_BAUDRATE))
+ #define UART4_BRR2_VALUE ((uint8_t)UART_BRR2_FROM(UART_FMASTER_VALUE, UART4_BAUDRATE))
+#endif /* UART4_BAUDRATE */
+#endif /* UART_FMASTER_VALUE */
+
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------- */
+
+/** @addtogroup UART_Exported_Functions
+  * @{
+  */
+
+void UART_DeInit(UART_TypeDef* UARTx);
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
+void UART_Init(UART_TypeDef* UARTx, uint32_t BaudRate, uint8_t WordLength,
+               uint8_t StopBits, uint8_t Parity, uint8_t SyncMode, uint8_t Mode);
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+void UART_InitBRR(UART_TypeDef* UARTx, uint8_t BRR1, uint8_t BRR2, uint8_t WordLength,
+                  uint8_t StopBits, uint8_t Parity, uint8_t SyncMode, uint8_t Mode);
+void UART_Cmd(UART_TypeDef* UARTx, FunctionalState NewState);
+void UART_ITConfig(UART_TypeDef* UARTx, uint16_t UART_IT, FunctionalState NewState);
+void UART_HalfDuplexCmd(UART_TypeDef* UARTx, FunctionalState NewState);
+#if defined (UART_IRDA_SUPPORT)
+void UART_IrDAConfig(UART_TypeDef* UARTx, uint8_t UART_IrDAMode);
+void UART_IrDACmd(UART_TypeDef* UARTx, FunctionalState NewState);
+#endif /* UART_IRDA_SUPPORT */
+#if defined (UART_LIN_SUPPORT)
+void UART_LINBreakDetectionConfig(UART_TypeDef* UARTx, uint8_t UART_LINBreakDetectionLength);
+void UART_LINCmd(UART_TypeDef* UARTx, FunctionalState NewState);
+#if defined (UART_CR6_PRESENT)
+void UART_LINConfig(UART_TypeDef* UARTx, uint8_t UART_Mode, uint8_t UART_Autosync,
+                    uint8_t UART_DivUp);
+#endif /* UART_CR6_PRESENT */
+#endif /* UART_LIN_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT)
+void UART_SmartCardCmd(UART_TypeDef* UARTx, FunctionalState NewState);
+void UART_SmartCardNACKCmd(UART_TypeDef* UARTx, FunctionalState NewState);
+#endif /* UART_SMARTCARD_SUPPORT */
+void UART_WakeUpConfig(UART_TypeDef* UARTx, uint8_t UART_WakeUp);
+void UART_ReceiverWakeUpCmd(UART_TypeDef* UARTx, FunctionalState NewState);
+uint16_t UART_ReceiveData9(UART_TypeDef* UARTx);
+void UART_SendData9(UART_TypeDef* UARTx, uint16_t Data);
+void UART_SetAddress(UART_TypeDef* UARTx, uint8_t UART_Address);
+FlagStatus UART_GetFlagStatus(UART_TypeDef* UARTx, uint16_t UART_FLAG);
+void UART_ClearFlag(UART_TypeDef* UARTx, uint16_t UART_FLAG);
+ITStatus UART_GetITStatus(UART_TypeDef* UARTx, uint16_t UART_IT);
+void UART_ClearITPendingBit(UART_TypeDef* UARTx, uint16_t UART_IT);
+#if defined (UART_BUFFER_SUPPORT)
+void UART_BufferCmd(UART_Buffer_TypeDef* UART_Buffer, FunctionalState NewState);
+uint8_t UART_Write(UART_Buffer_TypeDef* UART_Buffer, const uint8_t* Buffer, uint8_t Length);
+uint8_t UART_Read(UART_Buffer_TypeDef* UART_Buffer, uint8_t* Buffer, uint8_t Length);
+uint8_t UART_GetRxCount(UART_Buffer_TypeDef* UART_Buffer);
+uint8_t UART_GetTxFree(UART_Buffer_TypeDef* UART_Buffer);
+void UART_TxISR(UART_Buffer_TypeDef* UART_Buffer);
+void UART_RxISR(UART_Buffer_TypeDef* UART_Buffer);
+#endif /* UART_BUFFER_SUPPORT */
+
+/**
+  * @}
+  */
+
+#endif /* __STM8S_UART_H */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -31,6 +31,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm8s.h"
+#include "stm8s_uart.h"
 
 /** @addtogroup STM8S_StdPeriph_Driver
   * @{
@@ -170,6 +171,30 @@ typedef enum { UART1_IT_TXE        = (uint16_t)0x0277, /*!< Transmit interrupt *
   */
 
 /* Exported constants --------------------------------------------------------*/
+
+/** @addtogroup UART1_Exported_Constants
+  * @{
+  */
+
+/**
+  * @brief  Size in bytes of the UART1 transmit and receive ring buffers used by
+  *         UART1_Write() and UART1_Read().
+  * @note   Both sizes must be a power of two not greater than 128.
+  *         Tip: define them in your toolchain compiler preprocessor to resize
+  *         the buffers without modifying this file.
+  */
+#if !defined (UART1_TX_BUFFER_SIZE)
+ #define UART1_TX_BUFFER_SIZE (32)
+#endif /* UART1_TX_BUFFER_SIZE */
+
+#if !defined (UART1_RX_BUFFER_SIZE)
+ #define UART1_RX_BUFFER_SIZE (32)
+#endif /* UART1_RX_BUFFER_SIZE */
+
+/**
+  * @}
+  */
+
 /* Exported macros ------------------------------------------------------------*/
 
 /* Private macros ------------------------------------------------------------*/
@@ -343,18 +368,29 @@ typedef enum { UART1_IT_TXE        = (uint16_t)0x0277, /*!< Transmit interrupt *
   */
 
 void UART1_DeInit(void);
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength, 
                 UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
                 UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode);
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+void UART1_InitBRR(uint8_t BRR1, uint8_t BRR2, UART1_WordLength_TypeDef WordLength, 
+                   UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
+                   UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode);
 void UART1_Cmd(FunctionalState NewState);
 void UART1_ITConfig(UART1_IT_TypeDef UART1_IT, FunctionalState NewState);
 void UART1_HalfDuplexCmd(FunctionalState NewState);
+#if defined (UART_IRDA_SUPPORT)
 void UART1_IrDAConfig(UART1_IrDAMode_TypeDef UART1_IrDAMode);
 void UART1_IrDACmd(FunctionalState NewState);
+#endif /* UART_IRDA_SUPPORT */
+#if defined (UART_LIN_SUPPORT)
 void UART1_LINBreakDetectionConfig(UART1_LINBreakDetectionLength_TypeDef UART1_LINBreakDetectionLength);
 void UART1_LINCmd(FunctionalState NewState);
+#endif /* UART_LIN_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT)
 void UART1_SmartCardCmd(FunctionalState NewState);
 void UART1_SmartCardNACKCmd(FunctionalState NewState);
+#endif /* UART_SMARTCARD_SUPPORT */
 void UART1_WakeUpConfig(UART1_WakeUp_TypeDef UART1_WakeUp);
 void UART1_ReceiverWakeUpCmd(FunctionalState NewState);
 uint8_t UART1_ReceiveData8(void);
@@ -363,12 +399,25 @@ void UART1_SendData8(uint8_t Data);
 void UART1_SendData9(uint16_t Data);
 void UART1_SendBreak(void);
 void UART1_SetAddress(uint8_t UART1_Address);
+#if defined (UART_SMARTCARD_SUPPORT)
 void UART1_SetGuardTime(uint8_t UART1_GuardTime);
+#endif /* UART_SMARTCARD_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT) || defined (UART_IRDA_SUPPORT)
 void UART1_SetPrescaler(uint8_t UART1_Prescaler);
+#endif /* UART_SMARTCARD_SUPPORT || UART_IRDA_SUPPORT */
 FlagStatus UART1_GetFlagStatus(UART1_Flag_TypeDef UART1_FLAG);
 void UART1_ClearFlag(UART1_Flag_TypeDef UART1_FLAG);
 ITStatus UART1_GetITStatus(UART1_IT_TypeDef UART1_IT);
 void UART1_ClearITPendingBit(UART1_IT_TypeDef UART1_IT);
+#if defined (UART_BUFFER_SUPPORT)
+void UART1_BufferCmd(FunctionalState NewState);
+uint8_t UART1_Write(const uint8_t* Buffer, uint8_t Length);
+uint8_t UART1_Read(uint8_t* Buffer, uint8_t Length);
+uint8_t UART1_GetRxCount(void);
+uint8_t UART1_GetTxFree(void);
+void UART1_TxISR(void);
+void UART1_RxISR(void);
+#endif /* UART_BUFFER_SUPPORT */
 
 /**
   * @}
@@ -31,6 +31,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm8s.h"
+#include "stm8s_uart.h"
 
 /** @addtogroup STM8S_StdPeriph_Driver
   * @{
@@ -198,6 +199,30 @@ typedef enum { UART2_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
   */
 
 /* Exported constants --------------------------------------------------------*/
+
+/** @addtogroup UART2_Exported_Constants
+  * @{
+  */
+
+/**
+  * @brief  Size in bytes of the UART2 transmit and receive ring buffers used by
+  *         UART2_Write() and UART2_Read().
+  * @note   Both sizes must be a power of two not greater than 128.
+  *         Tip: define them in your toolchain compiler preprocessor to resize
+  *         the buffers without modifying this file.
+  */
+#if !defined (UART2_TX_BUFFER_SIZE)
+ #define UART2_TX_BUFFER_SIZE (32)
+#endif /* UART2_TX_BUFFER_SIZE */
+
+#if !defined (UART2_RX_BUFFER_SIZE)
+ #define UART2_RX_BUFFER_SIZE (32)
+#endif /* UART2_RX_BUFFER_SIZE */
+
+/**
+  * @}
+  */
+
 /* Exported macros ------------------------------------------------------------*/
 
 /* Private macros ------------------------------------------------------------*/
@@ -402,21 +427,32 @@ typedef enum { UART2_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
   */
 
 void UART2_DeInit(void);
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 void UART2_Init(uint32_t BaudRate, UART2_WordLength_TypeDef WordLength, 
                 UART2_StopBits_TypeDef StopBits, UART2_Parity_TypeDef Parity, 
                 UART2_SyncMode_TypeDef SyncMode, UART2_Mode_TypeDef Mode);
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+void UART2_InitBRR(uint8_t BRR1, uint8_t BRR2, UART2_WordLength_TypeDef WordLength, 
+                   UART2_StopBits_TypeDef StopBits, UART2_Parity_TypeDef Parity, 
+                   UART2_SyncMode_TypeDef SyncMode, UART2_Mode_TypeDef Mode);
 void UART2_Cmd(FunctionalState NewState);
 void UART2_ITConfig(UART2_IT_TypeDef UART2_IT, FunctionalState NewState);
 void UART2_HalfDuplexCmd(FunctionalState NewState);
+#if defined (UART_IRDA_SUPPORT)
 void UART2_IrDAConfig(UART2_IrDAMode_TypeDef UART2_IrDAMode);
 void UART2_IrDACmd(FunctionalState NewState);
+#endif /* UART_IRDA_SUPPORT */
+#if defined (UART_LIN_SUPPORT)
 void UART2_LINBreakDetectionConfig(UART2_LINBreakDetectionLength_TypeDef UART2_LINBreakDetectionLength);
 void UART2_LINConfig(UART2_LinMode_TypeDef UART2_Mode, 
                      UART2_LinAutosync_TypeDef UART2_Autosync, 
                      UART2_LinDivUp_TypeDef UART2_DivUp);
 void UART2_LINCmd(FunctionalState NewState);
+#endif /* UART_LIN_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT)
 void UART2_SmartCardCmd(FunctionalState NewState);
 void UART2_SmartCardNACKCmd(FunctionalState NewState);
+#endif /* UART_SMARTCARD_SUPPORT */
 void UART2_WakeUpConfig(UART2_WakeUp_TypeDef UART2_WakeUp);
 void UART2_ReceiverWakeUpCmd(FunctionalState NewState);
 uint8_t UART2_ReceiveData8(void);
@@ -425,12 +461,25 @@ void UART2_SendData8(uint8_t Data);
 void UART2_SendData9(uint16_t Data);
 void UART2_SendBreak(void);
 void UART2_SetAddress(uint8_t UART2_Address);
+#if defined (UART_SMARTCARD_SUPPORT)
 void UART2_SetGuardTime(uint8_t UART2_GuardTime);
+#endif /* UART_SMARTCARD_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT) || defined (UART_IRDA_SUPPORT)
 void UART2_SetPrescaler(uint8_t UART2_Prescaler);
+#endif /* UART_SMARTCARD_SUPPORT || UART_IRDA_SUPPORT */
 FlagStatus UART2_GetFlagStatus(UART2_Flag_TypeDef UART2_FLAG);
 void UART2_ClearFlag(UART2_Flag_TypeDef UART2_FLAG);
 ITStatus UART2_GetITStatus(UART2_IT_TypeDef UART2_IT);
 void UART2_ClearITPendingBit(UART2_IT_TypeDef UART2_IT);
+#if defined (UART_BUFFER_SUPPORT)
+void UART2_BufferCmd(FunctionalState NewState);
+uint8_t UART2_Write(const uint8_t* Buffer, uint8_t Length);
+uint8_t UART2_Read(uint8_t* Buffer, uint8_t Length);
+uint8_t UART2_GetRxCount(void);
+uint8_t UART2_GetTxFree(void);
+void UART2_TxISR(void);
+void UART2_RxISR(void);
+#endif /* UART_BUFFER_SUPPORT */
 
 
 /**
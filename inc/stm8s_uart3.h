@@ -31,6 +31,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm8s.h"
+#include "stm8s_uart.h"
 
 /** @addtogroup STM8S_StdPeriph_Driver
   * @{
@@ -175,6 +176,30 @@ typedef enum { UART3_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
   */
 
 /* Exported constants --------------------------------------------------------*/
+
+/** @addtogroup UART3_Exported_Constants
+  * @{
+  */
+
+/**
+  * @brief  Size in bytes of the UART3 transmit and receive ring buffers used by
+  *         UART3_Write() and UART3_Read().
+  * @note   Both sizes must be a power of two not greater than 128.
+  *         Tip: define them in your toolchain compiler preprocessor to resize
+  *         the buffers without modifying this file.
+  */
+#if !defined (UART3_TX_BUFFER_SIZE)
+ #define UART3_TX_BUFFER_SIZE (32)
+#endif /* UART3_TX_BUFFER_SIZE */
+
+#if !defined (UART3_RX_BUFFER_SIZE)
+ #define UART3_RX_BUFFER_SIZE (32)
+#endif /* UART3_RX_BUFFER_SIZE */
+
+/**
+  * @}
+  */
+
 /* Exported macros ------------------------------------------------------------*/
 
 /* Private macros ------------------------------------------------------------*/
@@ -353,16 +378,23 @@ typedef enum { UART3_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
   */
 
 void UART3_DeInit(void);
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength, 
                 UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
                 UART3_Mode_TypeDef Mode);
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+void UART3_InitBRR(uint8_t BRR1, uint8_t BRR2, UART3_WordLength_TypeDef WordLength, 
+                   UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
+                   UART3_Mode_TypeDef Mode);
 void UART3_Cmd(FunctionalState NewState);
 void UART3_ITConfig(UART3_IT_TypeDef UART3_IT, FunctionalState NewState);
+#if defined (UART_LIN_SUPPORT)
 void UART3_LINBreakDetectionConfig(UART3_LINBreakDetectionLength_TypeDef UART3_LINBreakDetectionLength);
 void UART3_LINConfig(UART3_LinMode_TypeDef UART3_Mode, 
                      UART3_LinAutosync_TypeDef UART3_Autosync, 
                      UART3_LinDivUp_TypeDef UART3_DivUp);
 void UART3_LINCmd(FunctionalState NewState);
+#endif /* UART_LIN_SUPPORT */
 void UART3_ReceiverWakeUpCmd(FunctionalState NewState);
 void UART3_WakeUpConfig( UART3_WakeUp_TypeDef UART3_WakeUp);
 uint8_t UART3_ReceiveData8(void);
@@ -375,6 +407,15 @@ FlagStatus UART3_GetFlagStatus(UART3_Flag_TypeDef UART3_FLAG);
 void UART3_ClearFlag(UART3_Flag_TypeDef UART3_FLAG);
 ITStatus UART3_GetITStatus(UART3_IT_TypeDef UART3_IT);
 void UART3_ClearITPendingBit(UART3_IT_TypeDef UART3_IT);
+#if defined (UART_BUFFER_SUPPORT)
+void UART3_BufferCmd(FunctionalState NewState);
+uint8_t UART3_Write(const uint8_t* Buffer, uint8_t Length);
+uint8_t UART3_Read(uint8_t* Buffer, uint8_t Length);
+uint8_t UART3_GetRxCount(void);
+uint8_t UART3_GetTxFree(void);
+void UART3_TxISR(void);
+void UART3_RxISR(void);
+#endif /* UART_BUFFER_SUPPORT */
 /**
   * @}
   */
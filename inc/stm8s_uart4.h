@@ -31,6 +31,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm8s.h"
+#include "stm8s_uart.h"
 
 /** @addtogroup STM8S_StdPeriph_Driver
   * @{
@@ -198,6 +199,30 @@ typedef enum { UART4_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
   */
 
 /* Exported constants --------------------------------------------------------*/
+
+/** @addtogroup UART4_Exported_Constants
+  * @{
+  */
+
+/**
+  * @brief  Size in bytes of the UART4 transmit and receive ring buffers used by
+  *         UART4_Write() and UART4_Read().
+  * @note   Both sizes must be a power of two not greater than 128.
+  *         Tip: define them in your toolchain compiler preprocessor to resize
+  *         the buffers without modifying this file.
+  */
+#if !defined (UART4_TX_BUFFER_SIZE)
+ #define UART4_TX_BUFFER_SIZE (32)
+#endif /* UART4_TX_BUFFER_SIZE */
+
+#if !defined (UART4_RX_BUFFER_SIZE)
+ #define UART4_RX_BUFFER_SIZE (32)
+#endif /* UART4_RX_BUFFER_SIZE */
+
+/**
+  * @}
+  */
+
 /* Exported macros -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 
@@ -399,21 +424,32 @@ typedef enum { UART4_IT_TXE        = (uint16_t)0x0277, /**< Transmit interrupt *
   * @{
   */
 void UART4_DeInit(void);
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, 
                 UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, 
                 UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode);
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+void UART4_InitBRR(uint8_t BRR1, uint8_t BRR2, UART4_WordLength_TypeDef WordLength, 
+                   UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, 
+                   UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode);
 void UART4_Cmd(FunctionalState NewState);
 void UART4_ITConfig(UART4_IT_TypeDef UART4_IT, FunctionalState NewState);
 void UART4_HalfDuplexCmd(FunctionalState NewState);
+#if defined (UART_IRDA_SUPPORT)
 void UART4_IrDAConfig(UART4_IrDAMode_TypeDef UART4_IrDAMode);
 void UART4_IrDACmd(FunctionalState NewState);
+#endif /* UART_IRDA_SUPPORT */
+#if defined (UART_LIN_SUPPORT)
 void UART4_LINBreakDetectionConfig(UART4_LINBreakDetectionLength_TypeDef UART4_LINBreakDetectionLength);
 void UART4_LINConfig(UART4_LinMode_TypeDef UART4_Mode, 
                      UART4_LinAutosync_TypeDef UART4_Autosync, 
                      UART4_LinDivUp_TypeDef UART4_DivUp);
 void UART4_LINCmd(FunctionalState NewState);
+#endif /* UART_LIN_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT)
 void UART4_SmartCardCmd(FunctionalState NewState);
 void UART4_SmartCardNACKCmd(FunctionalState NewState);
+#endif /* UART_SMARTCARD_SUPPORT */
 void UART4_WakeUpConfig(UART4_WakeUp_TypeDef UART4_WakeUp);
 void UART4_ReceiverWakeUpCmd(FunctionalState NewState);
 uint8_t UART4_ReceiveData8(void);
@@ -422,12 +458,25 @@ void UART4_SendData8(uint8_t Data);
 void UART4_SendData9(uint16_t Data);
 void UART4_SendBreak(void);
 void UART4_SetAddress(uint8_t UART4_Address);
+#if defined (UART_SMARTCARD_SUPPORT)
 void UART4_SetGuardTime(uint8_t UART4_GuardTime);
+#endif /* UART_SMARTCARD_SUPPORT */
+#if defined (UART_SMARTCARD_SUPPORT) || defined (UART_IRDA_SUPPORT)
 void UART4_SetPrescaler(uint8_t UART4_Prescaler);
+#endif /* UART_SMARTCARD_SUPPORT || UART_IRDA_SUPPORT */
 FlagStatus UART4_GetFlagStatus(UART4_Flag_TypeDef UART4_FLAG);
 void UART4_ClearFlag(UART4_Flag_TypeDef UART4_FLAG);
 ITStatus UART4_GetITStatus(UART4_IT_TypeDef UART4_IT);
 void UART4_ClearITPendingBit(UART4_IT_TypeDef UART4_IT);
+#if defined (UART_BUFFER_SUPPORT)
+void UART4_BufferCmd(FunctionalState NewState);
+uint8_t UART4_Write(const uint8_t* Buffer, uint8_t Length);
+uint8_t UART4_Read(uint8_t* Buffer, uint8_t Length);
+uint8_t UART4_GetRxCount(void);
+uint8_t UART4_GetTxFree(void);
+void UART4_TxISR(void);
+void UART4_RxISR(void);
+#endif /* UART_BUFFER_SUPPORT */
 
 
 /**
@@ -34,9 +34,80 @@
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
+#if defined (ADC1_SAMPLE_RATE_SUPPORT) && !defined (ADC1_SCAN_SUPPORT)
+ #error "ADC1_SAMPLE_RATE_SUPPORT needs ADC1_SCAN_SUPPORT"
+#endif
 /* Private variables ---------------------------------------------------------*/
+#if defined (ADC1_SCAN_SUPPORT)
+static uint16_t* ADC1_ScanBlocks[2];  /* Halves of the ping-pong buffer */
+static uint16_t* ADC1_ScanWrite = 0;  /* Where the next scan is copied */
+static ADC1_ScanCallback_TypeDef ADC1_ScanCallback = 0;
+static uint8_t ADC1_ScanLast = 0;     /* Last channel scanned */
+static uint8_t ADC1_ScanDepth = 0;    /* Scans in a block */
+static uint8_t ADC1_ScanLeft = 0;     /* Scans left to fill the current block */
+static volatile uint8_t ADC1_ScanCount = 0; /* Blocks filled, modulo 256 */
+static uint8_t ADC1_ScanSeen = 0;     /* ADC1_ScanCount at the last ADC1_GetScanBlock() */
+#endif /* ADC1_SCAN_SUPPORT */
+#if defined (ADC1_FILTER_SUPPORT)
+static ADC1_Filter_TypeDef ADC1_Filter;
+static ADC1_FilterCallback_TypeDef ADC1_FilterCallback = 0;
+static uint16_t ADC1_FilterSum = 0;   /* Sum of the conversions of the current sample */
+static uint8_t ADC1_FilterLeft = 0;   /* Conversions left to end the current sample */
+static uint8_t ADC1_FilterPrimed = 0; /* Filter states loaded with a first sample */
+static uint16_t ADC1_AverageRing[16]; /* Last samples of the moving average */
+static uint32_t ADC1_AverageSum = 0;
+static uint8_t ADC1_AverageIndex = 0;
+static uint32_t ADC1_IIRState = 0;    /* Output scaled by 2^IIRShift */
+static volatile uint16_t ADC1_FilterValue = 0;
+#endif /* ADC1_FILTER_SUPPORT */
+#if defined (ADC1_EVENT_SUPPORT)
+static uint16_t ADC1_EventLow[10];    /* Window of each channel */
+static uint16_t ADC1_EventHigh[10];
+static uint16_t ADC1_EventArmed = 0;  /* Channels watched, one bit per channel */
+static volatile uint16_t ADC1_EventPending = 0; /* Channels out of window since ADC1_EventWait() */
+static ADC1_EventCallback_TypeDef ADC1_EventCallback = 0;
+static uint8_t ADC1_EventLast = 0;    /* Last channel scanned */
+#endif /* ADC1_EVENT_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
+#if defined (ADC1_EVENT_SUPPORT)
+static void ADC1_EventProgram(void);
+#endif /* ADC1_EVENT_SUPPORT */
 /* Private functions ---------------------------------------------------------*/
+#if defined (ADC1_EVENT_SUPPORT)
+/**
+  * @brief  Programs the analog watchdog for the channels armed: the ADC1 has
+  *         a single window, so the intersection of their windows is used and
+  *         ADC1_EventISR() checks the window of each channel flagged.
+  * @param  None
+  * @retval None
+  */
+static void ADC1_EventProgram(void)
+{
+  uint16_t low = 0;
+  uint16_t high = 0x3FF;
+  uint8_t channel = 0;
+  
+  for (channel = 0; channel <= ADC1_EventLast; channel++)
+  {
+    if ((ADC1_EventArmed & (uint16_t)((uint16_t)1 << channel)) != 0)
+    {
+      if (ADC1_EventLow[channel] > low)
+      {
+        low = ADC1_EventLow[channel];
+      }
+      if (ADC1_EventHigh[channel] < high)
+      {
+        high = ADC1_EventHigh[channel];
+      }
+    }
+  }
+  
+  ADC1_SetLowThreshold(low);
+  ADC1_SetHighThreshold(high);
+  ADC1->AWCRL = (uint8_t)ADC1_EventArmed;
+  ADC1->AWCRH = (uint8_t)(ADC1_EventArmed >> 8);
+}
+#endif /* ADC1_EVENT_SUPPORT */
 /* Public functions ----------------------------------------------------------*/
 
 /**
@@ -493,6 +564,600 @@ uint16_t ADC1_GetBufferValue(uint8_t Buffer)
   return ((uint16_t)temph);
 }
 
+#if defined (ADC1_SCAN_SUPPORT)
+/**
+  * @brief  Starts the scan of the channels 0 to ADC1_LastChannel into the
+  *         data buffer registers; at each end of scan, ADC1_ScanISR() copies
+  *         them in one half of a ping-pong buffer, and calls Callback once
+  *         the half holds ADC1_Scans scans.
+  * @param   ADC1_ConversionMode: ADC1_CONVERSIONMODE_CONTINUOUS to scan
+  *         continuously, ADC1_CONVERSIONMODE_SINGLE to scan once on each
+  *         start (ADC1_StartConversion() or external trigger).
+  * @param   ADC1_LastChannel: last channel scanned, ADC1_CHANNEL_0 to ADC1_CHANNEL_9.
+  * @param   ADC1_Scans: number of scans in a block, 1 to 255.
+  * @param   Buffer: ping-pong buffer of 2 * ADC1_Scans * (ADC1_LastChannel + 1) values.
+  * @param   Callback: called from the interrupt with each block filled, 0 if
+  *         the blocks are polled with ADC1_GetScanBlock().
+  * @par Required preconditions:
+  *         ADC1 powered on (ADC1_Init() or ADC1_Cmd()) for the stabilization
+  *         time. The data are right aligned. When the external trigger is
+  *         enabled, the first scan waits for it. ADC1_ScanISR() is called
+  *         from the ADC1 interrupt routine.
+  * @retval None
+  */
+void ADC1_ScanStart(ADC1_ConvMode_TypeDef ADC1_ConversionMode, ADC1_Channel_TypeDef ADC1_LastChannel,
+                    uint8_t ADC1_Scans, uint16_t* Buffer, ADC1_ScanCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC1_CONVERSIONMODE_OK(ADC1_ConversionMode));
+  assert_param(IS_ADC1_BUFFER_OK(ADC1_LastChannel));
+  assert_param(IS_ADC1_SCANS_OK(ADC1_Scans));
+  
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOCIE);
+  
+  ADC1_ScanBlocks[0] = Buffer;
+  ADC1_ScanBlocks[1] = &Buffer[(uint16_t)((uint8_t)(ADC1_LastChannel + 1) * (uint16_t)ADC1_Scans)];
+  ADC1_ScanWrite = Buffer;
+  ADC1_ScanCallback = Callback;
+  ADC1_ScanLast = (uint8_t)ADC1_LastChannel;
+  ADC1_ScanDepth = ADC1_Scans;
+  ADC1_ScanLeft = ADC1_Scans;
+  ADC1_ScanCount = 0;
+  ADC1_ScanSeen = 0;
+  
+  ADC1_ConversionConfig(ADC1_ConversionMode, ADC1_LastChannel, ADC1_ALIGN_RIGHT);
+  ADC1->CR2 |= ADC1_CR2_SCAN;
+  ADC1->CR3 |= ADC1_CR3_DBUF;
+  ADC1->CR3 &= (uint8_t)(~ADC1_CR3_OVR);
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOC);
+  ADC1->CSR |= ADC1_CSR_EOCIE;
+  
+  if ((ADC1->CR2 & ADC1_CR2_EXTTRIG) == 0)
+  {
+    /* Start the first scan */
+    ADC1->CR1 |= ADC1_CR1_ADON;
+  }
+}
+
+/**
+  * @brief  Stops the scan engine: the continuous mode is left, the scan in
+  *         progress ends without notification.
+  * @param  None
+  * @retval None
+  */
+void ADC1_ScanStop(void)
+{
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOCIE);
+  ADC1->CR1 &= (uint8_t)(~ADC1_CR1_CONT);
+}
+
+/**
+  * @brief  Returns the block filled last if it was not returned yet.
+  * @param  None
+  * @retval Block of ADC1_Scans scans, valid until the next block is
+  *         filled; 0 if no new block.
+  */
+const uint16_t* ADC1_GetScanBlock(void)
+{
+  uint8_t count = ADC1_ScanCount;
+  
+  if (count == ADC1_ScanSeen)
+  {
+    return 0;
+  }
+  ADC1_ScanSeen = count;
+  
+  /* Blocks are filled alternately, the first one in ADC1_ScanBlocks[0] */
+  return ADC1_ScanBlocks[(uint8_t)(count + 1) & 0x01];
+}
+
+/**
+  * @brief  Copies the data buffer registers in the current half of the
+  *         ping-pong buffer, to be called from the ADC1 interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void ADC1_ScanISR(void)
+{
+  uint16_t* block = ADC1_ScanWrite;
+  uint8_t low = 0;
+  
+  /* One pass from the last channel, LSB read first (right alignment) */
+  switch (ADC1_ScanLast)
+  {
+    case 9:
+      low = ADC1->DB9RL;
+      block[9] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB9RH << 8) | low);
+      /* fall through */
+    case 8:
+      low = ADC1->DB8RL;
+      block[8] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB8RH << 8) | low);
+      /* fall through */
+    case 7:
+      low = ADC1->DB7RL;
+      block[7] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB7RH << 8) | low);
+      /* fall through */
+    case 6:
+      low = ADC1->DB6RL;
+      block[6] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB6RH << 8) | low);
+      /* fall through */
+    case 5:
+      low = ADC1->DB5RL;
+      block[5] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB5RH << 8) | low);
+      /* fall through */
+    case 4:
+      low = ADC1->DB4RL;
+      block[4] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB4RH << 8) | low);
+      /* fall through */
+    case 3:
+      low = ADC1->DB3RL;
+      block[3] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB3RH << 8) | low);
+      /* fall through */
+    case 2:
+      low = ADC1->DB2RL;
+      block[2] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB2RH << 8) | low);
+      /* fall through */
+    case 1:
+      low = ADC1->DB1RL;
+      block[1] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB1RH << 8) | low);
+      /* fall through */
+    default:
+      low = ADC1->DB0RL;
+      block[0] = (uint16_t)((uint16_t)((uint16_t)ADC1->DB0RH << 8) | low);
+      break;
+  }
+  
+  /* Clear the end of conversion and the overrun of a late interrupt */
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOC);
+  ADC1->CR3 &= (uint8_t)(~ADC1_CR3_OVR);
+  
+  ADC1_ScanWrite = &block[(uint8_t)(ADC1_ScanLast + 1)];
+  ADC1_ScanLeft--;
+  if (ADC1_ScanLeft == 0)
+  {
+    /* Block full: switch to the other half */
+    block = ADC1_ScanBlocks[ADC1_ScanCount & 0x01];
+    ADC1_ScanCount++;
+    ADC1_ScanWrite = ADC1_ScanBlocks[ADC1_ScanCount & 0x01];
+    ADC1_ScanLeft = ADC1_ScanDepth;
+    
+    if (ADC1_ScanCallback != 0)
+    {
+      ADC1_ScanCallback(block);
+    }
+  }
+}
+#endif /* ADC1_SCAN_SUPPORT */
+
+#if defined (ADC1_SAMPLE_RATE_SUPPORT)
+/**
+  * @brief  Starts the sampling of the channels 0 to ADC1_LastChannel at a
+  *         fixed rate: each update of TIM1 (TIM5 on STM8S903/STM8AF622x)
+  *         sends a TRGO event starting one scan, so the sampling instants
+  *         do not depend on the interrupt latency. The scans are delivered
+  *         in blocks by the scan engine (ADC1_ScanStart()).
+  * @param   ADC1_SampleRate: scans per second; the timer period is the
+  *         closest multiple of its prescaler, computed from fMASTER
+  *         (CLK_GetClockFreq()).
+  * @param   ADC1_LastChannel: last channel scanned, ADC1_CHANNEL_0 to ADC1_CHANNEL_9.
+  * @param   ADC1_Scans: number of scans in a block, 1 to 255.
+  * @param   Buffer: ping-pong buffer of 2 * ADC1_Scans * (ADC1_LastChannel + 1) values.
+  * @param   Callback: called from the interrupt with each block filled, 0 if
+  *         the blocks are polled with ADC1_GetScanBlock().
+  * @par Required preconditions:
+  *         ADC1 powered on (ADC1_Init() or ADC1_Cmd()). A scan, 14 ADC
+  *         clocks a channel plus the sampling time, is shorter than the
+  *         sampling period. The timer is used by this function only.
+  * @retval ERROR if the rate cannot be generated from fMASTER, SUCCESS otherwise
+  */
+ErrorStatus ADC1_SampleStart(uint32_t ADC1_SampleRate, ADC1_Channel_TypeDef ADC1_LastChannel,
+                             uint8_t ADC1_Scans, uint16_t* Buffer, ADC1_ScanCallback_TypeDef Callback)
+{
+  uint32_t ticks = 0;
+  uint16_t period = 0;
+#if defined (STM8S903) || defined (STM8AF622x)
+  uint8_t prescaler = 0;
+#else
+  uint16_t prescaler = 0;
+#endif /* STM8S903 || STM8AF622x */
+  
+  /* Check the parameters */
+  assert_param(IS_ADC1_SAMPLE_RATE_OK(ADC1_SampleRate));
+  
+  /* Timer clocks in a sampling period */
+  ticks = (CLK_GetClockFreq() + (ADC1_SampleRate >> 1)) / ADC1_SampleRate;
+  if (ticks < 2)
+  {
+    return ERROR;
+  }
+  
+#if defined (STM8S903) || defined (STM8AF622x)
+  /* TIM5 prescaler: power of two up to 32768 */
+  while ((prescaler < 15) && ((ticks >> prescaler) > (uint32_t)0x10000))
+  {
+    prescaler++;
+  }
+  if ((ticks >> prescaler) > (uint32_t)0x10000)
+  {
+    return ERROR;
+  }
+  period = (uint16_t)(((ticks + (((uint32_t)1 << prescaler) >> 1)) >> prescaler) - 1);
+  
+  TIM5_Cmd(DISABLE);
+  TIM5_TimeBaseInit((TIM5_Prescaler_TypeDef)prescaler, period);
+  TIM5_SelectOutputTrigger(TIM5_TRGOSOURCE_UPDATE);
+  /* Load the prescaler now, before the trigger is enabled */
+  TIM5_GenerateEvent(TIM5_EVENTSOURCE_UPDATE);
+#else
+  /* TIM1 prescaler: any division up to 65536 */
+  prescaler = (uint16_t)((ticks - 1) >> 16);
+  period = (uint16_t)(((ticks + (((uint32_t)prescaler + 1) >> 1)) / ((uint32_t)prescaler + 1)) - 1);
+  
+  TIM1_Cmd(DISABLE);
+  TIM1_TimeBaseInit(prescaler, TIM1_COUNTERMODE_UP, period, 0);
+  TIM1_SelectOutputTrigger(TIM1_TRGOSOURCE_UPDATE);
+  /* Load the prescaler now, before the trigger is enabled */
+  TIM1_GenerateEvent(TIM1_EVENTSOURCE_UPDATE);
+#endif /* STM8S903 || STM8AF622x */
+  
+  ADC1_ExternalTriggerConfig(ADC1_EXTTRIG_TIM, ENABLE);
+  ADC1_ScanStart(ADC1_CONVERSIONMODE_SINGLE, ADC1_LastChannel, ADC1_Scans, Buffer, Callback);
+  
+#if defined (STM8S903) || defined (STM8AF622x)
+  TIM5_Cmd(ENABLE);
+#else
+  TIM1_Cmd(ENABLE);
+#endif /* STM8S903 || STM8AF622x */
+  
+  return SUCCESS;
+}
+
+/**
+  * @brief  Stops the fixed rate sampling: the timer is stopped, the external
+  *         trigger disabled and the scan engine stopped.
+  * @param  None
+  * @retval None
+  */
+void ADC1_SampleStop(void)
+{
+#if defined (STM8S903) || defined (STM8AF622x)
+  TIM5_Cmd(DISABLE);
+#else
+  TIM1_Cmd(DISABLE);
+#endif /* STM8S903 || STM8AF622x */
+  ADC1_ExternalTriggerConfig(ADC1_EXTTRIG_TIM, DISABLE);
+  ADC1_ScanStop();
+}
+#endif /* ADC1_SAMPLE_RATE_SUPPORT */
+
+#if defined (ADC1_FILTER_SUPPORT)
+/**
+  * @brief  Starts the filter pipeline on ADC1_Channel: each end of
+  *         conversion interrupt adds the conversion to a sum of
+  *         2^Oversampling conversions; a full sum, shifted right by
+  *         Decimation, goes through the moving average and the IIR filter.
+  * @param   ADC1_ConversionMode: ADC1_CONVERSIONMODE_CONTINUOUS to convert
+  *         continuously, ADC1_CONVERSIONMODE_SINGLE to convert on each
+  *         external trigger, or on each interrupt when the external trigger
+  *         is disabled.
+  * @param   ADC1_Channel: channel converted.
+  * @param   Filter: pipeline settings, copied.
+  * @param   Callback: called from the interrupt with each filtered sample, 0
+  *         if the value is polled with ADC1_GetFilterValue().
+  * @par Required preconditions:
+  *         ADC1 powered on (ADC1_Init() or ADC1_Cmd()) for the stabilization
+  *         time. The data are right aligned. ADC1_FilterISR() is called from
+  *         the ADC1 interrupt routine.
+  * @retval None
+  */
+void ADC1_FilterStart(ADC1_ConvMode_TypeDef ADC1_ConversionMode, ADC1_Channel_TypeDef ADC1_Channel,
+                      const ADC1_Filter_TypeDef* Filter, ADC1_FilterCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC1_CONVERSIONMODE_OK(ADC1_ConversionMode));
+  assert_param(IS_ADC1_CHANNEL_OK(ADC1_Channel));
+  assert_param(IS_ADC1_FILTER_OK(Filter));
+  
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOCIE);
+  
+  ADC1_Filter = *Filter;
+  ADC1_FilterCallback = Callback;
+  ADC1_FilterSum = 0;
+  ADC1_FilterLeft = (uint8_t)(1 << Filter->Oversampling);
+  ADC1_FilterPrimed = 0;
+  ADC1_FilterValue = 0;
+  
+  ADC1_ConversionConfig(ADC1_ConversionMode, ADC1_Channel, ADC1_ALIGN_RIGHT);
+  ADC1->CR2 &= (uint8_t)(~ADC1_CR2_SCAN);
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOC);
+  ADC1->CSR |= ADC1_CSR_EOCIE;
+  
+  if ((ADC1->CR2 & ADC1_CR2_EXTTRIG) == 0)
+  {
+    /* Start the first conversion */
+    ADC1->CR1 |= ADC1_CR1_ADON;
+  }
+}
+
+/**
+  * @brief  Stops the filter pipeline: the continuous mode is left, the
+  *         conversion in progress ends without notification.
+  * @param  None
+  * @retval None
+  */
+void ADC1_FilterStop(void)
+{
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOCIE);
+  ADC1->CR1 &= (uint8_t)(~ADC1_CR1_CONT);
+}
+
+/**
+  * @brief  Returns the last filtered sample.
+  * @param  None
+  * @retval Filtered sample, 10 + Oversampling - Decimation bits; 0 until
+  *         the first sample ends.
+  */
+uint16_t ADC1_GetFilterValue(void)
+{
+  uint16_t value = 0;
+  uint8_t cc = 0;
+  
+  /* 16-bit value updated by the interrupt: read it atomically */
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  value = ADC1_FilterValue;
+  ITC_RestoreLevel(cc);
+  
+  return value;
+}
+
+/**
+  * @brief  Runs the filter pipeline on the conversion just ended, to be
+  *         called from the ADC1 interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void ADC1_FilterISR(void)
+{
+  uint16_t value = 0;
+  uint8_t index = 0;
+  
+  /* Right alignment: read LSB first, then MSB */
+  value = ADC1->DRL;
+  value |= (uint16_t)((uint16_t)ADC1->DRH << 8);
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_EOC);
+  
+  if (((ADC1->CR1 & ADC1_CR1_CONT) == 0) && ((ADC1->CR2 & ADC1_CR2_EXTTRIG) == 0))
+  {
+    /* Software started: start the next conversion */
+    ADC1->CR1 |= ADC1_CR1_ADON;
+  }
+  
+  /* Oversampling: 64 conversions of 10 bits fit in 16 bits */
+  ADC1_FilterSum += value;
+  ADC1_FilterLeft--;
+  if (ADC1_FilterLeft != 0)
+  {
+    return;
+  }
+  value = (uint16_t)(ADC1_FilterSum >> ADC1_Filter.Decimation);
+  ADC1_FilterSum = 0;
+  ADC1_FilterLeft = (uint8_t)(1 << ADC1_Filter.Oversampling);
+  
+  if (ADC1_FilterPrimed == 0)
+  {
+    /* First sample: load the filter states to avoid the initial ramp */
+    for (index = 0; index < (uint8_t)(1 << ADC1_Filter.AverageLength); index++)
+    {
+      ADC1_AverageRing[index] = value;
+    }
+    ADC1_AverageSum = (uint32_t)value << ADC1_Filter.AverageLength;
+    ADC1_AverageIndex = 0;
+    ADC1_IIRState = (uint32_t)value << ADC1_Filter.IIRShift;
+    ADC1_FilterPrimed = 1;
+  }
+  
+  if (ADC1_Filter.AverageLength != 0)
+  {
+    /* Moving average over a ring of 2^AverageLength samples */
+    ADC1_AverageSum -= ADC1_AverageRing[ADC1_AverageIndex];
+    ADC1_AverageSum += value;
+    ADC1_AverageRing[ADC1_AverageIndex] = value;
+    ADC1_AverageIndex = (uint8_t)((ADC1_AverageIndex + 1) & ((1 << ADC1_Filter.AverageLength) - 1));
+    value = (uint16_t)(ADC1_AverageSum >> ADC1_Filter.AverageLength);
+  }
+  
+  if (ADC1_Filter.IIRShift != 0)
+  {
+    /* y += (x - y) / 2^IIRShift, with y kept scaled by 2^IIRShift */
+    ADC1_IIRState -= ADC1_IIRState >> ADC1_Filter.IIRShift;
+    ADC1_IIRState += value;
+    value = (uint16_t)(ADC1_IIRState >> ADC1_Filter.IIRShift);
+  }
+  
+  ADC1_FilterValue = value;
+  if (ADC1_FilterCallback != 0)
+  {
+    ADC1_FilterCallback(value);
+  }
+}
+#endif /* ADC1_FILTER_SUPPORT */
+
+#if defined (ADC1_EVENT_SUPPORT)
+/**
+  * @brief  Sets the window of a channel watched by the threshold event
+  *         service and arms it.
+  * @param   Channel: channel, ADC1_CHANNEL_0 to ADC1_CHANNEL_9.
+  * @param   LowThreshold: lowest value inside the window.
+  * @param   HighThreshold: highest value inside the window, up to 0x3FF.
+  * @par Required preconditions:
+  *         Applied by the next ADC1_EventStart(), or at once if the service
+  *         runs and Channel is scanned.
+  * @retval None
+  */
+void ADC1_EventWindowConfig(ADC1_Channel_TypeDef Channel, uint16_t LowThreshold, uint16_t HighThreshold)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC1_BUFFER_OK(Channel));
+  assert_param(IS_ADC1_EVENT_WINDOW_OK(LowThreshold, HighThreshold));
+  
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_AWDIE);
+  
+  ADC1_EventLow[Channel] = LowThreshold;
+  ADC1_EventHigh[Channel] = HighThreshold;
+  ADC1_EventArmed |= (uint16_t)((uint16_t)1 << Channel);
+  
+  if ((ADC1->CR1 & ADC1_CR1_CONT) != 0)
+  {
+    ADC1_EventProgram();
+    ADC1->CSR |= ADC1_CSR_AWDIE;
+  }
+}
+
+/**
+  * @brief  Starts the threshold event service: the channels 0 to
+  *         ADC1_LastChannel are scanned continuously with the analog
+  *         watchdog enabled on the armed ones, and only the analog watchdog
+  *         interrupt is enabled, so the CPU sleeps until a channel leaves
+  *         the common window. A channel leaving its own window is disarmed,
+  *         flagged for ADC1_EventWait() and passed to Callback.
+  * @param   ADC1_LastChannel: last channel scanned, ADC1_CHANNEL_0 to ADC1_CHANNEL_9.
+  * @param   Callback: called from the interrupt with each channel leaving
+  *         its window, 0 if the events are polled with ADC1_EventWait().
+  * @par Required preconditions:
+  *         ADC1 powered on (ADC1_Init() or ADC1_Cmd()) for the stabilization
+  *         time, windows set with ADC1_EventWindowConfig(). Overlapping
+  *         windows avoid spurious interrupts: the hardware compares all the
+  *         channels to the intersection of the windows. ADC1_EventISR() is
+  *         called from the ADC1 interrupt routine.
+  * @retval None
+  */
+void ADC1_EventStart(ADC1_Channel_TypeDef ADC1_LastChannel, ADC1_EventCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC1_BUFFER_OK(ADC1_LastChannel));
+  
+  ADC1->CSR &= (uint8_t)(~(ADC1_CSR_AWDIE | ADC1_CSR_EOCIE));
+  
+  ADC1_EventCallback = Callback;
+  ADC1_EventLast = (uint8_t)ADC1_LastChannel;
+  ADC1_EventArmed &= (uint16_t)(((uint16_t)1 << (uint8_t)(ADC1_LastChannel + 1)) - 1);
+  ADC1_EventPending = 0;
+  ADC1_EventProgram();
+  
+  ADC1_ConversionConfig(ADC1_CONVERSIONMODE_CONTINUOUS, ADC1_LastChannel, ADC1_ALIGN_RIGHT);
+  ADC1->CR2 |= ADC1_CR2_SCAN;
+  ADC1->CR3 |= ADC1_CR3_DBUF;
+  ADC1->AWSRL = 0;
+  ADC1->AWSRH = 0;
+  ADC1->CSR &= (uint8_t)(~(ADC1_CSR_AWD | ADC1_CSR_EOC));
+  ADC1->CSR |= ADC1_CSR_AWDIE;
+  
+  /* Start the continuous scan */
+  ADC1->CR1 |= ADC1_CR1_ADON;
+}
+
+/**
+  * @brief  Arms again a channel disarmed by a threshold event.
+  * @param   Channel: channel, ADC1_CHANNEL_0 to ADC1_CHANNEL_9.
+  * @retval None
+  */
+void ADC1_EventRearm(ADC1_Channel_TypeDef Channel)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC1_BUFFER_OK(Channel));
+  
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_AWDIE);
+  ADC1_EventArmed |= (uint16_t)((uint16_t)1 << Channel);
+  ADC1_EventProgram();
+  ADC1->CSR |= ADC1_CSR_AWDIE;
+}
+
+/**
+  * @brief  Stops the threshold event service: the continuous mode is left
+  *         and the analog watchdog disabled.
+  * @param  None
+  * @retval None
+  */
+void ADC1_EventStop(void)
+{
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_AWDIE);
+  ADC1->CR1 &= (uint8_t)(~ADC1_CR1_CONT);
+  ADC1->AWCRL = 0;
+  ADC1->AWCRH = 0;
+}
+
+/**
+  * @brief  Waits in WFI mode for threshold events.
+  * @param  None
+  * @par Required preconditions:
+  *         Interrupts enabled. They are disabled while the events are
+  *         checked: WFI enables them again atomically, so an event cannot
+  *         be missed between the check and the sleep. The level of the
+  *         caller is restored on return.
+  * @retval Channels which left their window since the previous call, one
+  *         bit per channel.
+  */
+uint16_t ADC1_EventWait(void)
+{
+  uint16_t events = 0;
+  uint8_t cc = 0;
+  
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  while (ADC1_EventPending == 0)
+  {
+    wfi();
+    disableInterrupts();
+  }
+  events = ADC1_EventPending;
+  ADC1_EventPending = 0;
+  ITC_RestoreLevel(cc);
+  
+  return events;
+}
+
+/**
+  * @brief  Checks the channels flagged by the analog watchdog against their
+  *         own window, to be called from the ADC1 interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void ADC1_EventISR(void)
+{
+  uint16_t status = 0;
+  uint16_t mask = 0;
+  uint16_t value = 0;
+  uint8_t channel = 0;
+  
+  status = (uint16_t)(((uint16_t)ADC1->AWSRH << 8) | ADC1->AWSRL);
+  ADC1->AWSRL = 0;
+  ADC1->AWSRH = 0;
+  ADC1->CSR &= (uint8_t)(~ADC1_CSR_AWD);
+  
+  status &= ADC1_EventArmed;
+  for (channel = 0; channel <= ADC1_EventLast; channel++)
+  {
+    mask = (uint16_t)((uint16_t)1 << channel);
+    if ((status & mask) != 0)
+    {
+      value = ADC1_GetBufferValue(channel);
+      if ((value < ADC1_EventLow[channel]) || (value > ADC1_EventHigh[channel]))
+      {
+        /* Out of its own window: disarm it until ADC1_EventRearm() */
+        ADC1_EventArmed &= (uint16_t)(~mask);
+        ADC1_EventPending |= mask;
+        if (ADC1_EventCallback != 0)
+        {
+          ADC1_EventCallback((ADC1_Channel_TypeDef)channel, value);
+        }
+      }
+    }
+  }
+  
+  /* Narrow the common window to the channels still armed */
+  ADC1_EventProgram();
+}
+#endif /* ADC1_EVENT_SUPPORT */
+
 /**
   * @brief  Checks the specified analog watchdog channel status.
   * @param   Channel: specify the channel of which to check the analog watchdog
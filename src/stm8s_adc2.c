@@ -35,6 +35,25 @@
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined (ADC2_FILTER_SUPPORT)
+static ADC2_Filter_TypeDef ADC2_Filter;
+static ADC2_FilterCallback_TypeDef ADC2_FilterCallback = 0;
+static uint16_t ADC2_FilterSum = 0;   /* Sum of the conversions of the current sample */
+static uint8_t ADC2_FilterLeft = 0;   /* Conversions left to end the current sample */
+static uint8_t ADC2_FilterPrimed = 0; /* Filter states loaded with a first sample */
+static uint16_t ADC2_AverageRing[16]; /* Last samples of the moving average */
+static uint32_t ADC2_AverageSum = 0;
+static uint8_t ADC2_AverageIndex = 0;
+static uint32_t ADC2_IIRState = 0;    /* Output scaled by 2^IIRShift */
+static volatile uint16_t ADC2_FilterValue = 0;
+#endif /* ADC2_FILTER_SUPPORT */
+#if defined (ADC2_BURST_SUPPORT)
+static uint16_t* ADC2_BurstBuffer = 0;
+static uint16_t* ADC2_BurstWrite = 0; /* Where the next sample is stored */
+static volatile uint16_t ADC2_BurstLeft = 0; /* Samples left, 0 when no burst runs */
+static uint8_t ADC2_BurstCSR = 0;     /* CSR value clearing EOC: EOCIE and channel */
+static ADC2_BurstCallback_TypeDef ADC2_BurstCallback = 0;
+#endif /* ADC2_BURST_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
@@ -386,6 +405,270 @@ void ADC2_ClearITPendingBit(void)
   ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOC);
 }
 
+#if defined (ADC2_FILTER_SUPPORT)
+/**
+  * @brief  Starts the filter pipeline on ADC2_Channel: each end of
+  *         conversion interrupt adds the conversion to a sum of
+  *         2^Oversampling conversions; a full sum, shifted right by
+  *         Decimation, goes through the moving average and the IIR filter.
+  * @param   ADC2_ConversionMode: ADC2_CONVERSIONMODE_CONTINUOUS to convert
+  *         continuously, ADC2_CONVERSIONMODE_SINGLE to convert on each
+  *         external trigger, or on each interrupt when the external trigger
+  *         is disabled.
+  * @param   ADC2_Channel: channel converted.
+  * @param   Filter: pipeline settings, copied.
+  * @param   Callback: called from the interrupt with each filtered sample, 0
+  *         if the value is polled with ADC2_GetFilterValue().
+  * @par Required preconditions:
+  *         ADC2 powered on (ADC2_Init() or ADC2_Cmd()) for the stabilization
+  *         time. The data are right aligned. ADC2_FilterISR() is called from
+  *         the ADC2 interrupt routine.
+  * @retval None
+  */
+void ADC2_FilterStart(ADC2_ConvMode_TypeDef ADC2_ConversionMode, ADC2_Channel_TypeDef ADC2_Channel,
+                      const ADC2_Filter_TypeDef* Filter, ADC2_FilterCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC2_CONVERSIONMODE_OK(ADC2_ConversionMode));
+  assert_param(IS_ADC2_CHANNEL_OK(ADC2_Channel));
+  assert_param(IS_ADC2_FILTER_OK(Filter));
+  
+  ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOCIE);
+  
+  ADC2_Filter = *Filter;
+  ADC2_FilterCallback = Callback;
+  ADC2_FilterSum = 0;
+  ADC2_FilterLeft = (uint8_t)(1 << Filter->Oversampling);
+  ADC2_FilterPrimed = 0;
+  ADC2_FilterValue = 0;
+  
+  ADC2_ConversionConfig(ADC2_ConversionMode, ADC2_Channel, ADC2_ALIGN_RIGHT);
+  ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOC);
+  ADC2->CSR |= ADC2_CSR_EOCIE;
+  
+  if ((ADC2->CR2 & ADC2_CR2_EXTTRIG) == 0)
+  {
+    /* Start the first conversion */
+    ADC2->CR1 |= ADC2_CR1_ADON;
+  }
+}
+
+/**
+  * @brief  Stops the filter pipeline: the continuous mode is left, the
+  *         conversion in progress ends without notification.
+  * @param  None
+  * @retval None
+  */
+void ADC2_FilterStop(void)
+{
+  ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOCIE);
+  ADC2->CR1 &= (uint8_t)(~ADC2_CR1_CONT);
+}
+
+/**
+  * @brief  Returns the last filtered sample.
+  * @param  None
+  * @retval Filtered sample, 10 + Oversampling - Decimation bits; 0 until
+  *         the first sample ends.
+  */
+uint16_t ADC2_GetFilterValue(void)
+{
+  uint16_t value = 0;
+  uint8_t cc = 0;
+  
+  /* 16-bit value updated by the interrupt: read it atomically */
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  value = ADC2_FilterValue;
+  ITC_RestoreLevel(cc);
+  
+  return value;
+}
+
+/**
+  * @brief  Runs the filter pipeline on the conversion just ended, to be
+  *         called from the ADC2 interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void ADC2_FilterISR(void)
+{
+  uint16_t value = 0;
+  uint8_t index = 0;
+  
+  /* Right alignment: read LSB first, then MSB */
+  value = ADC2->DRL;
+  value |= (uint16_t)((uint16_t)ADC2->DRH << 8);
+  ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOC);
+  
+  if (((ADC2->CR1 & ADC2_CR1_CONT) == 0) && ((ADC2->CR2 & ADC2_CR2_EXTTRIG) == 0))
+  {
+    /* Software started: start the next conversion */
+    ADC2->CR1 |= ADC2_CR1_ADON;
+  }
+  
+  /* Oversampling: 64 conversions of 10 bits fit in 16 bits */
+  ADC2_FilterSum += value;
+  ADC2_FilterLeft--;
+  if (ADC2_FilterLeft != 0)
+  {
+    return;
+  }
+  value = (uint16_t)(ADC2_FilterSum >> ADC2_Filter.Decimation);
+  ADC2_FilterSum = 0;
+  ADC2_FilterLeft = (uint8_t)(1 << ADC2_Filter.Oversampling);
+  
+  if (ADC2_FilterPrimed == 0)
+  {
+    /* First sample: load the filter states to avoid the initial ramp */
+    for (index = 0; index < (uint8_t)(1 << ADC2_Filter.AverageLength); index++)
+    {
+      ADC2_AverageRing[index] = value;
+    }
+    ADC2_AverageSum = (uint32_t)value << ADC2_Filter.AverageLength;
+    ADC2_AverageIndex = 0;
+    ADC2_IIRState = (uint32_t)value << ADC2_Filter.IIRShift;
+    ADC2_FilterPrimed = 1;
+  }
+  
+  if (ADC2_Filter.AverageLength != 0)
+  {
+    /* Moving average over a ring of 2^AverageLength samples */
+    ADC2_AverageSum -= ADC2_AverageRing[ADC2_AverageIndex];
+    ADC2_AverageSum += value;
+    ADC2_AverageRing[ADC2_AverageIndex] = value;
+    ADC2_AverageIndex = (uint8_t)((ADC2_AverageIndex + 1) & ((1 << ADC2_Filter.AverageLength) - 1));
+    value = (uint16_t)(ADC2_AverageSum >> ADC2_Filter.AverageLength);
+  }
+  
+  if (ADC2_Filter.IIRShift != 0)
+  {
+    /* y += (x - y) / 2^IIRShift, with y kept scaled by 2^IIRShift */
+    ADC2_IIRState -= ADC2_IIRState >> ADC2_Filter.IIRShift;
+    ADC2_IIRState += value;
+    value = (uint16_t)(ADC2_IIRState >> ADC2_Filter.IIRShift);
+  }
+  
+  ADC2_FilterValue = value;
+  if (ADC2_FilterCallback != 0)
+  {
+    ADC2_FilterCallback(value);
+  }
+}
+#endif /* ADC2_FILTER_SUPPORT */
+
+#if defined (ADC2_BURST_SUPPORT)
+/**
+  * @brief  Starts a burst: ADC2_Channel is converted continuously and
+  *         ADC2_BurstISR() stores Count samples in Buffer, then leaves the
+  *         continuous mode and calls Callback.
+  * @param   ADC2_Channel: channel converted.
+  * @param   Buffer: buffer of Count values, right aligned.
+  * @param   Count: number of samples, 1 to 65535.
+  * @param   Callback: called from the interrupt once the buffer is filled, 0
+  *         if the end is polled with ADC2_GetBurstStatus().
+  * @par Required preconditions:
+  *         ADC2 powered on (ADC2_Init() or ADC2_Cmd()) for the stabilization
+  *         time. ADC2 has no overrun flag: the prescaler is chosen so that a
+  *         conversion (14 ADC clocks) is longer than the interrupt routine,
+  *         otherwise samples are lost. When the external trigger is enabled,
+  *         the burst waits for it. ADC2_BurstISR() is called from the ADC2
+  *         interrupt routine.
+  * @retval None
+  */
+void ADC2_BurstStart(ADC2_Channel_TypeDef ADC2_Channel, uint16_t* Buffer, uint16_t Count,
+                     ADC2_BurstCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_ADC2_CHANNEL_OK(ADC2_Channel));
+  assert_param(IS_ADC2_BURST_COUNT_OK(Count));
+  
+  ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOCIE);
+  
+  ADC2_BurstBuffer = Buffer;
+  ADC2_BurstWrite = Buffer;
+  ADC2_BurstCallback = Callback;
+  ADC2_BurstCSR = (uint8_t)(ADC2_CSR_EOCIE | (uint8_t)ADC2_Channel);
+  ADC2_BurstLeft = Count;
+  
+  ADC2_ConversionConfig(ADC2_CONVERSIONMODE_CONTINUOUS, ADC2_Channel, ADC2_ALIGN_RIGHT);
+  /* Clear EOC and enable the interrupt */
+  ADC2->CSR = ADC2_BurstCSR;
+  
+  if ((ADC2->CR2 & ADC2_CR2_EXTTRIG) == 0)
+  {
+    /* Start the continuous conversion */
+    ADC2->CR1 |= ADC2_CR1_ADON;
+  }
+}
+
+/**
+  * @brief  Stops the burst in progress, without notification.
+  * @param  None
+  * @retval None
+  */
+void ADC2_BurstStop(void)
+{
+  ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOCIE);
+  ADC2->CR1 &= (uint8_t)(~ADC2_CR1_CONT);
+  ADC2_BurstLeft = 0;
+}
+
+/**
+  * @brief  Checks whether the burst is complete.
+  * @param  None
+  * @retval SET when no burst is in progress, RESET otherwise.
+  */
+FlagStatus ADC2_GetBurstStatus(void)
+{
+  FlagStatus status = RESET;
+  uint8_t cc = 0;
+  
+  /* 16-bit counter updated by the interrupt: read it atomically */
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  if (ADC2_BurstLeft == 0)
+  {
+    status = SET;
+  }
+  ITC_RestoreLevel(cc);
+  
+  return status;
+}
+
+/**
+  * @brief  Stores the conversion of a burst, to be called from the ADC2
+  *         interrupt routine; it returns at once when no burst runs.
+  * @param  None
+  * @retval None
+  */
+void ADC2_BurstISR(void)
+{
+  if (ADC2_BurstLeft == 0)
+  {
+    return;
+  }
+  
+  /* Right alignment set by ADC2_BurstStart(): LSB first, then MSB, stored
+     at once in the big endian sample */
+  ((uint8_t*)ADC2_BurstWrite)[1] = ADC2->DRL;
+  ((uint8_t*)ADC2_BurstWrite)[0] = ADC2->DRH;
+  ADC2_BurstWrite++;
+  /* Clear EOC with a single write */
+  ADC2->CSR = ADC2_BurstCSR;
+  
+  ADC2_BurstLeft--;
+  if (ADC2_BurstLeft == 0)
+  {
+    ADC2->CR1 &= (uint8_t)(~ADC2_CR1_CONT);
+    ADC2->CSR &= (uint8_t)(~ADC2_CSR_EOCIE);
+    
+    if (ADC2_BurstCallback != 0)
+    {
+      ADC2_BurstCallback(ADC2_BurstBuffer);
+    }
+  }
+}
+#endif /* ADC2_BURST_SUPPORT */
+
 /**
   * @}
   */
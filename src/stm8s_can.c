@@ -32,12 +32,76 @@
   * @{
   */
 /* Private typedef -----------------------------------------------------------*/
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+/* Identifier block of the filter planner: identifiers equal to Id on the
+   bits set in Care */
+typedef struct
+{
+  uint32_t Id;
+  uint32_t Care;
+  uint8_t  IDE;
+}CAN_FilterBlock_TypeDef;
+#endif /* CAN_FILTER_PLAN_SUPPORT */
 /* Private define ------------------------------------------------------------*/
 #define CAN_IDLIST_IDMASK_MASK ((uint8_t) 0x55)
 #define CAN_IDMASK_IDLIST_MASK ((uint8_t) 0xAA)
 #define CAN_MODE_MASK ((uint8_t) 0x03)
 #define CAN_ACKNOWLEDGE_TIMEOUT ((uint16_t)0xFFFF)
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+#define CAN_FILTER_BANKS       ((uint8_t)0x06)
+#define CAN_FILTER_IDE         ((uint8_t)0x08) /* IDE bit of the second filter byte */
+/* Filter kinds, list ones even; a 32-bit filter takes a whole bank, the
+   other ones a half bank */
+#define CAN_FILTER_KIND_LIST32 ((uint8_t)0x00) /* Single extended identifier */
+#define CAN_FILTER_KIND_MASK32 ((uint8_t)0x01) /* Extended identifier block */
+#define CAN_FILTER_KIND_LIST16 ((uint8_t)0x02) /* Single standard identifier */
+#define CAN_FILTER_KIND_MASK16 ((uint8_t)0x03) /* Block not matching EXID[14:0] */
+#define CAN_FILTER_KIND_LIST8  ((uint8_t)0x04) /* Block of 8 standard identifiers */
+#define CAN_FILTER_KIND_MASK8  ((uint8_t)0x05) /* Block matching STID[10:3] only */
+#define CAN_FILTER_KINDS       ((uint8_t)0x06)
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+#if defined (CAN_BIT_TIMING_SUPPORT)
+#define CAN_BIT_QUANTA_MIN     ((uint8_t)8)  /* Time quanta in a bit: sync, BS1 and BS2 */
+#define CAN_BIT_QUANTA_MAX     ((uint8_t)25)
+#define CAN_BITRATE_TOLERANCE  ((uint32_t)200) /* Bit rate error up to 1/200 (0.5%) */
+#endif /* CAN_BIT_TIMING_SUPPORT */
+#if defined (CAN_STATISTICS_SUPPORT)
+#define CAN_FRAME_BITS_STD     ((uint8_t)47) /* Standard frame without data, stuff bits and intermission included */
+#define CAN_FRAME_BITS_EXT     ((uint8_t)67) /* Extended frame without data, stuff bits and intermission included */
+#endif /* CAN_STATISTICS_SUPPORT */
 /* Private macro -------------------------------------------------------------*/
+#if defined (CAN_TX_QUEUE_SUPPORT)
+/* The TX interrupt is kept enabled while frames are queued, and while the
+   statistics record the transmitted frames */
+#if defined (CAN_STATISTICS_SUPPORT)
+#define CAN_TX_IT_NEEDED() ((CAN_TxCount != 0) || (CAN_StatsEnabled != FALSE))
+#else
+#define CAN_TX_IT_NEEDED() (CAN_TxCount != 0)
+#endif /* CAN_STATISTICS_SUPPORT */
+#endif /* CAN_TX_QUEUE_SUPPORT */
+#if defined (CAN_STATISTICS_SUPPORT)
+#if !defined (CAN_RX_FIFO_SUPPORT)
+ #error "CAN_STATISTICS_SUPPORT needs CAN_RX_FIFO_SUPPORT"
+#endif
+#if !IS_CAN_STATISTICS_IDS_OK(CAN_STATISTICS_IDS)
+ #error "CAN_STATISTICS_IDS must be between 1 and 32"
+#endif
+#endif /* CAN_STATISTICS_SUPPORT */
+#if defined (CAN_TX_QUEUE_SUPPORT)
+#if !IS_CAN_TX_QUEUE_SIZE_OK(CAN_TX_QUEUE_SIZE)
+ #error "CAN_TX_QUEUE_SIZE must be between 1 and 32"
+#endif
+#endif /* CAN_TX_QUEUE_SUPPORT */
+#if defined (CAN_RX_FIFO_SUPPORT)
+#if !IS_CAN_FIFO_SIZE_OK(CAN_RX_FIFO_SIZE)
+ #error "CAN_RX_FIFO_SIZE must be a power of two between 2 and 128"
+#endif
+#endif /* CAN_RX_FIFO_SUPPORT */
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+#if !IS_CAN_FILTER_PLAN_SIZE_OK(CAN_FILTER_PLAN_SIZE)
+ #error "CAN_FILTER_PLAN_SIZE must be between 3 and 64"
+#endif
+#endif /* CAN_FILTER_PLAN_SUPPORT */
 /* Private variables ---------------------------------------------------------*/
 __IO uint32_t _Id = 0;
 __IO uint8_t _IDE = 0;
@@ -45,8 +109,57 @@ __IO uint8_t _RTR = 0;
 __IO uint8_t _DLC = 0;
 __IO uint8_t _Data[8] = {0};
 __IO uint8_t _FMI = 0;
+#if defined (CAN_RX_FIFO_SUPPORT)
+static CAN_Frame_TypeDef CAN_RxFrames[CAN_RX_FIFO_SIZE]; /* Receive ring */
+static volatile uint8_t CAN_RxHead = 0; /* Written by CAN_RxISR() */
+static volatile uint8_t CAN_RxTail = 0; /* Written by CAN_ReadFrame() */
+static volatile uint8_t CAN_RxLost = 0; /* Frames lost, saturates at 255 */
+#endif /* CAN_RX_FIFO_SUPPORT */
+#if defined (CAN_TX_QUEUE_SUPPORT)
+static CAN_Frame_TypeDef CAN_TxFrames[CAN_TX_QUEUE_SIZE]; /* Queued frames */
+static uint32_t CAN_TxKeys[CAN_TX_QUEUE_SIZE];  /* Arbitration key of each frame */
+/* Frame indexes: CAN_TxCount first ones queued by priority, then free ones */
+static uint8_t CAN_TxOrder[CAN_TX_QUEUE_SIZE];
+static uint8_t CAN_TxCount = 0;
+static bool CAN_TxOrderInit = FALSE;
+#endif /* CAN_TX_QUEUE_SUPPORT */
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+/* Bytes of an identifier in each filter kind */
+static const uint8_t CAN_FilterWidths[CAN_FILTER_KINDS] = {4, 4, 2, 2, 1, 1};
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+#if defined (CAN_STATISTICS_SUPPORT)
+static CAN_Statistics_TypeDef CAN_Stats;
+static bool CAN_StatsEnabled = FALSE;
+static bool CAN_StatsStarted = FALSE; /* CAN_StatsStamp valid */
+static uint16_t CAN_StatsStamp = 0;   /* Latest time stamp recorded */
+static uint32_t CAN_LoadBits = 0;     /* Frame bits in the current window */
+static uint32_t CAN_LoadTime = 0;     /* Bit times in the current window */
+#endif /* CAN_STATISTICS_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 static ITStatus CheckITStatus(uint8_t CAN_Reg, uint8_t It_Bit);
+#if defined (CAN_RX_FIFO_SUPPORT)
+static void CAN_GetFIFOFrame(CAN_Frame_TypeDef* CAN_Frame);
+#endif /* CAN_RX_FIFO_SUPPORT */
+#if defined (CAN_RX_FIFO_SUPPORT) || defined (CAN_TX_QUEUE_SUPPORT)
+static void CAN_CopyFrame(CAN_Frame_TypeDef* Destination, const CAN_Frame_TypeDef* Source);
+#endif /* CAN_RX_FIFO_SUPPORT || CAN_TX_QUEUE_SUPPORT */
+#if defined (CAN_TX_QUEUE_SUPPORT)
+static uint32_t CAN_GetArbitrationKey(const CAN_Frame_TypeDef* CAN_Frame);
+static ErrorStatus CAN_LoadMailbox(const CAN_Frame_TypeDef* CAN_Frame);
+#endif /* CAN_TX_QUEUE_SUPPORT */
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+static uint8_t CAN_CountBits(uint32_t Value);
+static ErrorStatus CAN_MergeFilterBlocks(CAN_FilterBlock_TypeDef* Blocks, uint8_t Count, bool Lossless);
+static uint8_t CAN_GetFilterKind(const CAN_FilterBlock_TypeDef* Block, FunctionalState Scale8);
+static uint8_t CAN_GetFilterBankCount(const CAN_FilterBlock_TypeDef* Blocks, uint8_t Count, FunctionalState Scale8);
+static void CAN_EncodeFilterBytes(uint8_t* Bytes, uint32_t Value, uint8_t IDE, uint8_t Width, uint8_t Flags);
+static void CAN_SetFilterBank(uint8_t Number, uint8_t LowWidth, uint8_t HighWidth, uint8_t Lists, const uint8_t* Bytes);
+static void CAN_ProgramFilterPlan(const CAN_FilterBlock_TypeDef* Blocks, uint8_t Count, FunctionalState Scale8);
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+#if defined (CAN_STATISTICS_SUPPORT)
+static void CAN_RecordLoad(uint16_t TimeStamp, uint8_t IDE, uint8_t RTR, uint8_t DLC);
+static void CAN_RecordRxFrame(const CAN_Frame_TypeDef* CAN_Frame);
+#endif /* CAN_STATISTICS_SUPPORT */
 
 /* Private functions ---------------------------------------------------------*/
 /**
@@ -145,7 +258,7 @@ CAN_InitStatus_TypeDef CAN_Init(CAN_MasterCtrl_TypeDef CAN_MasterCtrl,
     CAN->MCR |= (uint8_t)CAN_MasterCtrl;
     
     /* Set the bit timing register */
-    CAN->DGR |= (uint8_t)CAN_Mode ;
+    CAN->DGR = (uint8_t)((uint8_t)(CAN->DGR & (uint8_t)(~CAN_MODE_MASK)) | (uint8_t)CAN_Mode);
     CAN->PSR = CAN_Page_Config;
     CAN->Page.Config.BTR1 = (uint8_t)((uint8_t)(CAN_Prescaler - (uint8_t)1) | CAN_SynJumpWidth);
     CAN->Page.Config.BTR2 = (uint8_t)(CAN_BitSeg1 | (uint8_t)CAN_BitSeg2);
@@ -319,12 +432,14 @@ void CAN_FilterInit(CAN_FilterNumber_TypeDef CAN_FilterNumber,
     else if ( CAN_FilterMode == CAN_FilterMode_IdList_IdMask)
     {
       /*Identifier list mode is first  for the filter*/
-      CAN->Page.Config.FMR1 |= (uint8_t)(fmhl & CAN_IDLIST_IDMASK_MASK);
+      CAN->Page.Config.FMR1 = (uint8_t)((uint8_t)(CAN->Page.Config.FMR1 & (uint8_t)~(fmhl)) |
+                                      (uint8_t)(fmhl & CAN_IDLIST_IDMASK_MASK));
     }
     else /* ( CAN_FilterMode == CAN_FilterMode_IdMask_IdList)*/
     {
       /*Id Mask mode is first  for the filter*/
-      CAN->Page.Config.FMR1 |= (uint8_t)(fmhl & CAN_IDMASK_IDLIST_MASK);
+      CAN->Page.Config.FMR1 = (uint8_t)((uint8_t)(CAN->Page.Config.FMR1 & (uint8_t)~(fmhl)) |
+                                      (uint8_t)(fmhl & CAN_IDMASK_IDLIST_MASK));
     }
     
     
@@ -346,12 +461,14 @@ void CAN_FilterInit(CAN_FilterNumber_TypeDef CAN_FilterNumber,
     else if ( CAN_FilterMode == CAN_FilterMode_IdList_IdMask)
     {
       /*Identifier list mode is first  for the filter*/
-      CAN->Page.Config.FMR2 |= (uint8_t)(fmhl & CAN_IDLIST_IDMASK_MASK);
+      CAN->Page.Config.FMR2 = (uint8_t)((uint8_t)(CAN->Page.Config.FMR2 & (uint8_t)~(fmhl)) |
+                                      (uint8_t)(fmhl & CAN_IDLIST_IDMASK_MASK));
     }
     else /* ( CAN_FilterMode == CAN_FilterMode_IdMask_IdList)*/
     {
       /*Id Mask mode is first  for the filter*/
-      CAN->Page.Config.FMR2 |= (uint8_t)(fmhl & CAN_IDMASK_IDLIST_MASK);
+      CAN->Page.Config.FMR2 = (uint8_t)((uint8_t)(CAN->Page.Config.FMR2 & (uint8_t)~(fmhl)) |
+                                      (uint8_t)(fmhl & CAN_IDMASK_IDLIST_MASK));
     }
   }
   /*---------------------------------------------------------*/
@@ -1419,27 +1536,1386 @@ void CAN_SelectPage(CAN_Page_TypeDef CAN_Page)
   CAN->PSR = (uint8_t)CAN_Page;
 }
 
+#if defined (CAN_RX_FIFO_SUPPORT)
 /**
-  * @brief  Checks whether the CAN interrupt has occurred or not.
-  * @param   CAN_Reg: specifies the CAN interrupt register to check.
-  * @param   It_Bit: specifies the interrupt source bit to check.
-  * @retval The new state of the CAN Interrupt, which can be one of ITStatus.
+  * @brief  Enables or disables the RAM receive FIFO: when enabled, every
+  *         frame received is moved by CAN_RxISR() from the 3-message hardware
+  *         FIFO to a ring of CAN_RX_FIFO_SIZE frames read by CAN_ReadFrame().
+  * @param  NewState : new state of the receive FIFO.
+  *         This parameter can be any of the @ref FunctionalState enumeration.
+  * @note   CAN_RxISR() must be called from the CAN RX interrupt routine.
+  *         Enabling the FIFO empties it and clears the lost frame count.
+  * @retval None
   */
-static ITStatus CheckITStatus(uint8_t CAN_Reg, uint8_t It_Bit)
+void CAN_RxFIFOCmd(FunctionalState NewState)
 {
-  ITStatus pendingbitstatus = RESET;
-  if ((CAN_Reg & It_Bit) != (uint8_t)RESET)
+  /* Check the parameters */
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+
+  if (NewState != DISABLE)
   {
-    /* CAN_IT is set */
-    pendingbitstatus = SET;
+    CAN->IER &= (uint8_t)(~(CAN_IER_FMPIE | CAN_IER_FOVIE));
+    CAN_RxTail = CAN_RxHead;
+    CAN_RxLost = 0;
+    CAN->IER |= (uint8_t)(CAN_IER_FMPIE | CAN_IER_FOVIE);
   }
   else
   {
-    /* CAN_IT is reset */
-    pendingbitstatus = RESET;
+    CAN->IER &= (uint8_t)(~(CAN_IER_FMPIE | CAN_IER_FOVIE));
+  }
+}
+
+/**
+  * @brief  Reads the oldest frame of the RAM receive FIFO.
+  * @param  CAN_Frame : receives the frame (Id, IDE, RTR, DLC, FMI and the
+  *         DLC first data bytes).
+  * @retval ErrorStatus : ERROR if the FIFO is empty.
+  */
+ErrorStatus CAN_ReadFrame(CAN_Frame_TypeDef* CAN_Frame)
+{
+  uint8_t tail = CAN_RxTail;
+
+  if (tail == CAN_RxHead)
+  {
+    return ERROR;
+  }
+
+  CAN_CopyFrame(CAN_Frame, &CAN_RxFrames[tail & (uint8_t)(CAN_RX_FIFO_SIZE - 1)]);
+  CAN_RxTail = (uint8_t)(tail + 1);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  Returns the number of frames waiting in the RAM receive FIFO.
+  * @param  None
+  * @retval uint8_t : number of frames to be read by CAN_ReadFrame().
+  */
+uint8_t CAN_GetRxFrameCount(void)
+{
+  return (uint8_t)(CAN_RxHead - CAN_RxTail);
+}
+
+/**
+  * @brief  Returns the number of frames lost since the FIFO was enabled,
+  *         because the RAM FIFO was full or the hardware FIFO overran.
+  * @param  None
+  * @retval uint8_t : number of frames lost, saturated at 255.
+  */
+uint8_t CAN_GetRxLostCount(void)
+{
+  return CAN_RxLost;
+}
+
+/**
+  * @brief  Moves all the frames pending in the hardware FIFO to the RAM
+  *         receive FIFO, to be called from the CAN RX interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void CAN_RxISR(void)
+{
+  CAN_Page_TypeDef can_page = CAN_GetSelectedPage();
+  uint8_t head = CAN_RxHead;
+
+  /* select Fifo page*/
+  CAN->PSR = CAN_Page_RxFifo;
+
+  while ((CAN->RFR & CAN_RFR_FMP01) != 0)
+  {
+    if ((uint8_t)(head - CAN_RxTail) < (uint8_t)CAN_RX_FIFO_SIZE)
+    {
+      CAN_GetFIFOFrame(&CAN_RxFrames[head & (uint8_t)(CAN_RX_FIFO_SIZE - 1)]);
+#if defined (CAN_STATISTICS_SUPPORT)
+      if (CAN_StatsEnabled != FALSE)
+      {
+        CAN_RecordRxFrame(&CAN_RxFrames[head & (uint8_t)(CAN_RX_FIFO_SIZE - 1)]);
+      }
+#endif /* CAN_STATISTICS_SUPPORT */
+      head++;
+    }
+    else if (CAN_RxLost != 0xFF)
+    {
+      CAN_RxLost++;
+    }
+    /* Release the output mailbox, the next message then appears in the page */
+    CAN->RFR = CAN_RFR_RFOM;
+    while ((CAN->RFR & CAN_RFR_RFOM) != 0)
+    {}
+  }
+  CAN_RxHead = head;
+
+  if ((CAN->RFR & CAN_RFR_FOVR) != 0)
+  {
+    CAN->RFR = CAN_RFR_FOVR; /*rc-w1*/
+    if (CAN_RxLost != 0xFF)
+    {
+      CAN_RxLost++;
+    }
+  }
+
+  /*Restore Last Page*/
+  CAN_SelectPage(can_page);
+}
+#endif /* CAN_RX_FIFO_SUPPORT */
+
+#if defined (CAN_TX_QUEUE_SUPPORT)
+/**
+  * @brief  Sends a frame: it is written at once in an empty mailbox, or else
+  *         queued in RAM by arbitration priority and written by CAN_TxISR()
+  *         as soon as a mailbox is empty. Only the DLC first data bytes are
+  *         copied.
+  * @param   CAN_Frame: frame to be sent (Id, IDE, RTR, DLC and Data).
+  * @note   CAN_TxISR() must be called from the CAN TX interrupt routine. It
+  *         clears the RQCPx bits, so CAN_TransmitStatus() cannot be used
+  *         for the mailboxes filled from the queue.
+  * @retval ERROR if the queue is full.
+  */
+ErrorStatus CAN_TransmitFrame(const CAN_Frame_TypeDef* CAN_Frame)
+{
+  ErrorStatus status = SUCCESS;
+  uint8_t can_page = CAN->PSR;
+  uint8_t slot = 0, position = 0, cc = 0;
+  uint32_t key = 0;
+
+  /* Check the parameters */
+  assert_param(IS_CAN_IDTYPE_OK(CAN_Frame->IDE));
+  if (CAN_Frame->IDE != CAN_Id_Standard)
+  {
+    assert_param(IS_CAN_EXTID_OK(CAN_Frame->Id));
+  }
+  else
+  {
+    assert_param(IS_CAN_STDID_OK(CAN_Frame->Id));
+  }
+  assert_param(IS_CAN_RTR_OK(CAN_Frame->RTR));
+  assert_param(IS_CAN_DLC_OK(CAN_Frame->DLC));
+
+  /* CAN_TxISR() also runs on the error interrupts sharing its vector
+     (statistics): all the interrupts are masked while the queue changes */
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+
+  if (CAN_TxOrderInit == FALSE)
+  {
+    for (slot = 0; slot < (uint8_t)CAN_TX_QUEUE_SIZE; slot++)
+    {
+      CAN_TxOrder[slot] = slot;
+    }
+    CAN_TxOrderInit = TRUE;
+  }
+
+  if ((CAN_TxCount != 0) || (CAN_LoadMailbox(CAN_Frame) == ERROR))
+  {
+    if (CAN_TxCount < (uint8_t)CAN_TX_QUEUE_SIZE)
+    {
+      /* Insert after the frames of same or higher priority */
+      key = CAN_GetArbitrationKey(CAN_Frame);
+      slot = CAN_TxOrder[CAN_TxCount];
+      position = CAN_TxCount;
+      while ((position != 0) && (CAN_TxKeys[CAN_TxOrder[position - 1]] > key))
+      {
+        CAN_TxOrder[position] = CAN_TxOrder[position - 1];
+        position--;
+      }
+      CAN_TxOrder[position] = slot;
+      CAN_TxKeys[slot] = key;
+      CAN_CopyFrame(&CAN_TxFrames[slot], CAN_Frame);
+      CAN_TxCount++;
+    }
+    else
+    {
+      status = ERROR;
+    }
+  }
+
+  if (CAN_TX_IT_NEEDED())
+  {
+    CAN->IER |= CAN_IER_TMEIE;
+  }
+
+  /*Restore Last Page*/
+  CAN->PSR = can_page;
+  ITC_RestoreLevel(cc);
+
+  return status;
+}
+
+/**
+  * @brief  Returns the number of frames waiting for a transmit mailbox.
+  * @param  None
+  * @retval uint8_t : number of frames queued by CAN_TransmitFrame().
+  */
+uint8_t CAN_GetTxQueueCount(void)
+{
+  return CAN_TxCount;
+}
+
+/**
+  * @brief  Writes the queued frames of highest priority in the empty
+  *         transmit mailboxes, to be called from the CAN TX interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void CAN_TxISR(void)
+{
+  uint8_t can_page = CAN->PSR;
+  uint8_t slot = 0, i = 0;
+
+  /* Acknowledge the completed requests */
+  CAN->TSR = CAN_TSR_RQCP012; /*rc-w1*/
+
+  while ((CAN_TxCount != 0) && (CAN_LoadMailbox(&CAN_TxFrames[CAN_TxOrder[0]]) != ERROR))
+  {
+    /* Remove the first frame, its slot becomes the first free one */
+    slot = CAN_TxOrder[0];
+    CAN_TxCount--;
+    for (i = 0; i < CAN_TxCount; i++)
+    {
+      CAN_TxOrder[i] = CAN_TxOrder[i + 1];
+    }
+    CAN_TxOrder[CAN_TxCount] = slot;
+  }
+
+  if (!CAN_TX_IT_NEEDED())
+  {
+    CAN->IER &= (uint8_t)(~CAN_IER_TMEIE);
+  }
+
+  /*Restore Last Page*/
+  CAN->PSR = can_page;
+}
+#endif /* CAN_TX_QUEUE_SUPPORT */
+
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+/**
+  * @brief  Computes and programs the six filter banks so that the given
+  *         identifiers are accepted and, as far as the banks allow, all the
+  *         other ones are rejected by the hardware.
+  *         The ranges are split in aligned blocks of identifiers, each one
+  *         set in the cheapest filter: 32-bit list (2 extended identifiers
+  *         a bank) or mask, 16-bit list (4 standard identifiers a bank) or
+  *         mask (2 blocks a bank, also extended blocks not matching
+  *         EXID[14:0]). When the banks are too few, adjacent blocks are
+  *         joined, then 8-bit filters on STID[10:3] are used, then the
+  *         closest blocks are widened.
+  * @param   CAN_Ranges: identifier ranges to accept.
+  * @param   CAN_Count: number of ranges, 0 rejects all the frames.
+  * @par Required preconditions:
+  *         The unused filter banks are deactivated. List filters match the
+  *         data frames only, mask filters the data and remote frames.
+  *         The filter match index of a frame is not related to its range.
+  * @retval CAN_FilterPlanStatus_Exact when only the requested identifiers
+  *         are accepted, CAN_FilterPlanStatus_Widened otherwise
+  */
+CAN_FilterPlanStatus_TypeDef CAN_FilterPlan(const CAN_FilterRange_TypeDef* CAN_Ranges, uint8_t CAN_Count)
+{
+  CAN_FilterBlock_TypeDef blocks[CAN_FILTER_PLAN_SIZE];
+  CAN_FilterPlanStatus_TypeDef status = CAN_FilterPlanStatus_Exact;
+  FunctionalState scale8 = DISABLE;
+  uint32_t first = 0;
+  uint32_t size = 0;
+  uint32_t care = 0;
+  uint8_t count = 0;
+  uint8_t range = 0;
+  uint8_t i = 0;
+  
+  for (range = 0; range < CAN_Count; range++)
+  {
+    /* Check the parameters */
+    assert_param(IS_CAN_IDTYPE_OK(CAN_Ranges[range].IDE));
+    assert_param(IS_CAN_FILTER_RANGE_OK(CAN_Ranges[range].First, CAN_Ranges[range].Last, CAN_Ranges[range].IDE));
+    
+    first = CAN_Ranges[range].First;
+    while (first <= CAN_Ranges[range].Last)
+    {
+      /* Largest aligned block starting at first and ending in the range */
+      size = 1;
+      while (((first & ((size << 1) - 1)) == 0) &&
+             ((first + ((size << 1) - 1)) <= CAN_Ranges[range].Last))
+      {
+        size <<= 1;
+      }
+      if (CAN_Ranges[range].IDE != CAN_Id_Standard)
+      {
+        care = CAN_EXTID_SIZE & ~(size - 1);
+      }
+      else
+      {
+        care = CAN_STDID_SIZE & ~(size - 1);
+      }
+      
+      /* Skip the blocks already covered */
+      for (i = 0; i < count; i++)
+      {
+        if ((blocks[i].IDE == CAN_Ranges[range].IDE) && ((care & blocks[i].Care) == blocks[i].Care) &&
+            (((first ^ blocks[i].Id) & blocks[i].Care) == 0))
+        {
+          break;
+        }
+      }
+      if (i == count)
+      {
+        if (count == (uint8_t)CAN_FILTER_PLAN_SIZE)
+        {
+          /* Work list full: join two blocks */
+          if (CAN_MergeFilterBlocks(blocks, count, TRUE) == ERROR)
+          {
+            CAN_MergeFilterBlocks(blocks, count, FALSE);
+            status = CAN_FilterPlanStatus_Widened;
+          }
+          count--;
+        }
+        blocks[count].Id = first;
+        blocks[count].Care = care;
+        blocks[count].IDE = (uint8_t)CAN_Ranges[range].IDE;
+        count++;
+      }
+      first += size;
+    }
+  }
+  
+  while (CAN_GetFilterBankCount(blocks, count, DISABLE) > CAN_FILTER_BANKS)
+  {
+    if (CAN_MergeFilterBlocks(blocks, count, TRUE) == SUCCESS)
+    {
+      count--;
+    }
+    else if (CAN_GetFilterBankCount(blocks, count, ENABLE) <= CAN_FILTER_BANKS)
+    {
+      /* 8-bit filters also accept the extended frames with the same STID[10:3] */
+      scale8 = ENABLE;
+      status = CAN_FilterPlanStatus_Widened;
+      break;
+    }
+    else
+    {
+      CAN_MergeFilterBlocks(blocks, count, FALSE);
+      count--;
+      status = CAN_FilterPlanStatus_Widened;
+    }
+  }
+  
+  CAN_ProgramFilterPlan(blocks, count, scale8);
+  
+  return status;
+}
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+
+#if defined (CAN_BIT_TIMING_SUPPORT)
+/**
+  * @brief  Computes the CAN_Init() bit timing parameters giving a bit rate
+  *         from the master clock frequency (CLK_GetClockFreq()).
+  *         The closest bit rate is chosen first, then the closest sample
+  *         point, then the most time quanta (8 to 25) in a bit.
+  * @param   CAN_BitRate: bit rate in bit/s, 1000 to 1000000.
+  * @param   CAN_SamplePoint: sample point in per mille of the bit, 500 to
+  *         900 (875 recommended by CANopen and DeviceNet).
+  * @param   CAN_BitTiming: receives the bit timing; the synchronisation
+  *         jump width is the largest one allowed by the bit segment 2.
+  * @retval SUCCESS when the bit rate is generated within 0.5%, ERROR
+  *         otherwise (CAN_BitTiming is then left unchanged)
+  */
+ErrorStatus CAN_ComputeBitTiming(uint32_t CAN_BitRate, uint16_t CAN_SamplePoint, CAN_BitTiming_TypeDef* CAN_BitTiming)
+{
+  uint32_t fmaster = CLK_GetClockFreq();
+  uint32_t clocks = 0;
+  uint32_t prescaler = 0;
+  uint32_t error = 0;
+  uint32_t best_error = 0xFFFFFFFF;
+  uint16_t point_error = 0;
+  uint16_t best_point_error = 0xFFFF;
+  uint8_t quanta = 0;
+  uint8_t seg1 = 0;
+  uint8_t seg2 = 0;
+  
+  /* Check the parameters */
+  assert_param(IS_CAN_BITRATE_OK(CAN_BitRate));
+  assert_param(IS_CAN_SAMPLE_POINT_OK(CAN_SamplePoint));
+  
+  for (quanta = CAN_BIT_QUANTA_MAX; quanta >= CAN_BIT_QUANTA_MIN; quanta--)
+  {
+    clocks = CAN_BitRate * quanta;
+    prescaler = (fmaster + (clocks >> 1)) / clocks;
+    if ((prescaler == 0) || (prescaler > 64))
+    {
+      continue;
+    }
+    if ((prescaler * clocks) > fmaster)
+    {
+      error = (prescaler * clocks) - fmaster;
+    }
+    else
+    {
+      error = fmaster - (prescaler * clocks);
+    }
+    
+    /* Sample point at the end of the bit segment 1, after the sync quantum */
+    seg1 = (uint8_t)((uint8_t)(((uint16_t)((uint16_t)quanta * CAN_SamplePoint) + 500) / 1000) - 1);
+    if (seg1 > 16)
+    {
+      seg1 = 16;
+    }
+    seg2 = (uint8_t)(quanta - 1 - seg1);
+    if (seg2 > 8)
+    {
+      /* Too many quanta for the bit segments */
+      continue;
+    }
+    if (seg2 == 0)
+    {
+      seg1--;
+      seg2 = 1;
+    }
+    point_error = (uint16_t)((uint16_t)((uint16_t)(seg1 + 1) * 1000) / quanta);
+    if (point_error > CAN_SamplePoint)
+    {
+      point_error -= CAN_SamplePoint;
+    }
+    else
+    {
+      point_error = (uint16_t)(CAN_SamplePoint - point_error);
+    }
+    
+    if ((error < best_error) || ((error == best_error) && (point_error < best_point_error)))
+    {
+      best_error = error;
+      best_point_error = point_error;
+      CAN_BitTiming->Prescaler = (uint8_t)prescaler;
+      CAN_BitTiming->BitSeg1 = (CAN_BitSeg1_TypeDef)(seg1 - 1);
+      CAN_BitTiming->BitSeg2 = (CAN_BitSeg2_TypeDef)((uint8_t)(seg2 - 1) << 4);
+      if (seg2 > 4)
+      {
+        seg2 = 4;
+      }
+      CAN_BitTiming->SynJumpWidth = (CAN_SynJumpWidth_TypeDef)((uint8_t)(seg2 - 1) << 6);
+    }
+  }
+  
+  if ((best_error == 0xFFFFFFFF) || ((best_error * CAN_BITRATE_TOLERANCE) > fmaster))
+  {
+    return ERROR;
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  Detects the bit rate of the bus: the CAN is initialized in silent
+  *         mode (no acknowledge nor error frame sent) at each candidate bit
+  *         rate until a frame is received without error, then initialized
+  *         in normal mode at this bit rate.
+  * @param   CAN_MasterCtrl : Master control option, can be one or a combination of @ref CAN_MasterCtrl_TypeDef.
+  * @param   CAN_BitRates: candidate bit rates in bit/s, most likely first.
+  * @param   CAN_Count: number of candidate bit rates.
+  * @param   CAN_SamplePoint: sample point in per mille of the bit, 500 to 900.
+  * @param   CAN_Timeout: number of status polls waiting for a frame at each
+  *         bit rate; it must cover the longest silence expected on the bus.
+  * @par Required preconditions:
+  *         The frame received, if accepted by the filters, is left in the
+  *         receive FIFO.
+  * @retval Bit rate detected, 0 when none (the CAN is then left in silent
+  *         mode at the last candidate bit rate)
+  */
+uint32_t CAN_AutoBaud(CAN_MasterCtrl_TypeDef CAN_MasterCtrl, const uint32_t* CAN_BitRates, uint8_t CAN_Count,
+                      uint16_t CAN_SamplePoint, uint32_t CAN_Timeout)
+{
+  CAN_BitTiming_TypeDef timing;
+  CAN_Page_TypeDef can_page = CAN_GetSelectedPage();
+  uint32_t bitrate = 0;
+  uint32_t polls = 0;
+  uint8_t lec = 0;
+  uint8_t i = 0;
+  
+  /* Check the parameters */
+  assert_param(IS_CAN_MASTERCTRL_OK(CAN_MasterCtrl));
+  assert_param(IS_CAN_SAMPLE_POINT_OK(CAN_SamplePoint));
+  
+  for (i = 0; (i < CAN_Count) && (bitrate == 0); i++)
+  {
+    if (CAN_ComputeBitTiming(CAN_BitRates[i], CAN_SamplePoint, &timing) == ERROR)
+    {
+      continue;
+    }
+    if (CAN_Init(CAN_MasterCtrl, CAN_Mode_Silent, timing.SynJumpWidth, timing.BitSeg1,
+                 timing.BitSeg2, timing.Prescaler) == CAN_InitStatus_Failed)
+    {
+      continue;
+    }
+    
+    /* The last error code set to 7 by software is updated by the hardware
+       at the end of the next frame: 0 when received without error */
+    CAN->PSR = CAN_Page_Config;
+    CAN->Page.Config.ESR = (uint8_t)((uint8_t)(CAN->Page.Config.ESR & (uint8_t)(~CAN_ESR_LEC)) |
+                                     (uint8_t)CAN_ErrorCode_SoftwareSetErr);
+    lec = (uint8_t)CAN_ErrorCode_SoftwareSetErr;
+    for (polls = CAN_Timeout; (polls != 0) && (lec == (uint8_t)CAN_ErrorCode_SoftwareSetErr); polls--)
+    {
+      lec = (uint8_t)(CAN->Page.Config.ESR & CAN_ESR_LEC);
+    }
+    if (lec == (uint8_t)CAN_ErrorCode_NoErr)
+    {
+      bitrate = CAN_BitRates[i];
+    }
+  }
+  
+  if (bitrate != 0)
+  {
+    if (CAN_Init(CAN_MasterCtrl, CAN_Mode_Normal, timing.SynJumpWidth, timing.BitSeg1,
+                 timing.BitSeg2, timing.Prescaler) == CAN_InitStatus_Failed)
+    {
+      bitrate = 0;
+    }
+  }
+  
+  /*Restore Last Page*/
+  CAN_SelectPage(can_page);
+  
+  return bitrate;
+}
+#endif /* CAN_BIT_TIMING_SUPPORT */
+
+#if defined (CAN_STATISTICS_SUPPORT)
+/**
+  * @brief  Enables or disables the bus statistics. When enabled, the time
+  *         triggered communication mode is set so that every frame gets the
+  *         time stamp of its start of frame (in bit times), the statistics
+  *         are cleared and the TX and error interrupts are enabled.
+  * @param   NewState : new state of the statistics, one of @ref FunctionalState.
+  * @par Required preconditions:
+  *         The RAM receive FIFO is enabled (CAN_RxFIFOCmd()); only the
+  *         frames accepted by the filters are counted. CAN_StatisticsISR()
+  *         is called from the CAN TX interrupt routine, before CAN_TxISR().
+  *         The TGT bits are left cleared: the time stamp is not sent.
+  * @retval None
+  */
+void CAN_StatisticsCmd(FunctionalState NewState)
+{
+  CAN_Page_TypeDef can_page = CAN_GetSelectedPage();
+  uint8_t ier = CAN->IER;
+  uint8_t i = 0;
+  
+  /* Check the parameters */
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  
+  CAN->IER = 0;
+  CAN->PSR = CAN_Page_Config;
+  if (NewState != DISABLE)
+  {
+    CAN_Stats.RxFrames = 0;
+    CAN_Stats.TxFrames = 0;
+    CAN_Stats.OtherFrames = 0;
+    for (i = 0; i < 6; i++)
+    {
+      CAN_Stats.Errors[i] = 0;
+    }
+    CAN_Stats.Load = 0;
+    CAN_Stats.IdCount = 0;
+    CAN_StatsStarted = FALSE;
+    CAN_LoadBits = 0;
+    CAN_LoadTime = 0;
+    CAN_StatsEnabled = TRUE;
+    
+    CAN->MCR |= CAN_MCR_TTCM;
+    CAN->Page.Config.EIER |= (uint8_t)(CAN_EIER_ERRIE | CAN_EIER_LECIE);
+    ier |= CAN_IER_TMEIE;
+  }
+  else
+  {
+    CAN_StatsEnabled = FALSE;
+    CAN->Page.Config.EIER &= (uint8_t)(~(uint8_t)(CAN_EIER_ERRIE | CAN_EIER_LECIE));
+#if defined (CAN_TX_QUEUE_SUPPORT)
+    if (CAN_TxCount == 0)
+#endif /* CAN_TX_QUEUE_SUPPORT */
+    {
+      ier &= (uint8_t)(~CAN_IER_TMEIE);
+    }
+  }
+  CAN->IER = ier;
+  
+  /*Restore Last Page*/
+  CAN_SelectPage(can_page);
+}
+
+/**
+  * @brief  Reads the bus statistics.
+  * @param   CAN_Statistics: receives the statistics.
+  * @retval None
+  */
+void CAN_GetStatistics(CAN_Statistics_TypeDef* CAN_Statistics)
+{
+  CAN_Page_TypeDef can_page = CAN_GetSelectedPage();
+  uint8_t ier = CAN->IER;
+  uint8_t eier = 0;
+  
+  /* Copy a consistent snapshot, the CAN interrupts masked */
+  CAN->IER = 0;
+  CAN->PSR = CAN_Page_Config;
+  eier = CAN->Page.Config.EIER;
+  CAN->Page.Config.EIER = (uint8_t)(eier & (uint8_t)(~CAN_EIER_ERRIE));
+  
+  *CAN_Statistics = CAN_Stats;
+  CAN_Statistics->TxErrorCounter = CAN->Page.Config.TECR;
+  CAN_Statistics->RxErrorCounter = CAN->Page.Config.RECR;
+  
+  CAN->Page.Config.EIER = eier;
+  CAN->IER = ier;
+  
+  /*Restore Last Page*/
+  CAN_SelectPage(can_page);
+}
+
+/**
+  * @brief  Records the frames transmitted and the errors detected, to be
+  *         called from the CAN TX interrupt routine.
+  * @param  None
+  * @note   It clears the RQCPx bits of the completed requests, so
+  *         CAN_TransmitStatus() cannot be used with the statistics enabled.
+  * @retval None
+  */
+void CAN_StatisticsISR(void)
+{
+  uint8_t can_page = CAN->PSR;
+  uint8_t tsr = CAN->TSR;
+  uint8_t mailbox = 0;
+  uint8_t midr1 = 0;
+  uint8_t lec = 0;
+  uint16_t stamp = 0;
+  
+  for (mailbox = 0; mailbox < 3; mailbox++)
+  {
+    if ((tsr & (uint8_t)(CAN_TSR_TXOK0 << mailbox)) != 0)
+    {
+      if (mailbox == 2)
+      {
+        CAN->PSR = CAN_Page_TxMailBox2;
+      }
+      else
+      {
+        CAN->PSR = mailbox;
+      }
+      midr1 = CAN->Page.TxMailbox.MIDR1;
+      stamp = (uint16_t)((uint16_t)((uint16_t)CAN->Page.TxMailbox.MTSRH << 8) | CAN->Page.TxMailbox.MTSRL);
+      CAN_RecordLoad(stamp, (uint8_t)(midr1 & CAN_Id_Extended), (uint8_t)(midr1 & CAN_RTR_Remote),
+                     (uint8_t)(CAN->Page.TxMailbox.MDLCR & (uint8_t)0x0F));
+      CAN_Stats.TxFrames++;
+    }
+  }
+  /* Acknowledge the completed requests */
+  CAN->TSR = (uint8_t)(tsr & CAN_TSR_RQCP012); /*rc-w1*/
+  
+  if ((CAN->MSR & CAN_MSR_ERRI) != 0)
+  {
+    lec = (uint8_t)CAN_GetLastErrorCode();
+    if ((lec >= (uint8_t)CAN_ErrorCode_StuffErr) && (lec <= (uint8_t)CAN_ErrorCode_CRCErr))
+    {
+      lec = (uint8_t)((uint8_t)(lec >> 4) - 1);
+      if (CAN_Stats.Errors[lec] != 0xFFFF)
+      {
+        CAN_Stats.Errors[lec]++;
+      }
+    }
+    CAN->MSR = CAN_MSR_ERRI; /*rc-w1*/
+  }
+  
+  /*Restore Last Page*/
+  CAN->PSR = can_page;
+}
+#endif /* CAN_STATISTICS_SUPPORT */
+
+/**
+  * @brief  Checks whether the CAN interrupt has occurred or not.
+  * @param   CAN_Reg: specifies the CAN interrupt register to check.
+  * @param   It_Bit: specifies the interrupt source bit to check.
+  * @retval The new state of the CAN Interrupt, which can be one of ITStatus.
+  */
+static ITStatus CheckITStatus(uint8_t CAN_Reg, uint8_t It_Bit)
+{
+  ITStatus pendingbitstatus = RESET;
+  if ((CAN_Reg & It_Bit) != (uint8_t)RESET)
+  {
+    /* CAN_IT is set */
+    pendingbitstatus = SET;
+  }
+  else
+  {
+    /* CAN_IT is reset */
+    pendingbitstatus = RESET;
+  }
+  return (ITStatus)pendingbitstatus;
+}
+
+#if defined (CAN_RX_FIFO_SUPPORT)
+/**
+  * @brief  Reads the frame in the output mailbox of the hardware FIFO; only
+  *         the DLC first data bytes are copied.
+  * @param   CAN_Frame: receives the frame.
+  * @par Required preconditions:
+  * The CAN_Page_RxFifo page must be selected.
+  * @retval None
+  */
+static void CAN_GetFIFOFrame(CAN_Frame_TypeDef* CAN_Frame)
+{
+  uint8_t midr1 = CAN->Page.RxFIFO.MIDR1;
+  uint8_t dlc = 0, i = 0;
+  __IO uint8_t* data = &CAN->Page.RxFIFO.MDAR1;
+
+  CAN_Frame->IDE = (uint8_t)(midr1 & CAN_Id_Extended);
+  CAN_Frame->RTR = (uint8_t)(midr1 & CAN_RTR_Remote);
+  if (CAN_Frame->IDE != CAN_Id_Standard)
+  {
+    CAN_Frame->Id = ((uint32_t)((uint8_t)(midr1 & 0x1F)) << 24) |
+                    ((uint32_t)CAN->Page.RxFIFO.MIDR2 << 16) |
+                    ((uint16_t)((uint16_t)CAN->Page.RxFIFO.MIDR3 << 8)) |
+                    CAN->Page.RxFIFO.MIDR4;
+  }
+  else
+  {
+    CAN_Frame->Id = (uint16_t)((uint16_t)((uint16_t)((uint8_t)(midr1 & 0x1F)) << 6) |
+                               (uint8_t)(CAN->Page.RxFIFO.MIDR2 >> 2));
+  }
+
+  dlc = (uint8_t)(CAN->Page.RxFIFO.MDLCR & (uint8_t)0x0F);
+  if (dlc > CAN_DLC_MAX)
+  {
+    dlc = CAN_DLC_MAX;
+  }
+  CAN_Frame->DLC = dlc;
+  CAN_Frame->FMI = CAN->Page.RxFIFO.MFMI;
+  for (i = 0; i < dlc; i++)
+  {
+    CAN_Frame->Data[i] = data[i];
+  }
+#if defined (CAN_STATISTICS_SUPPORT)
+  CAN_Frame->TimeStamp = (uint16_t)((uint16_t)((uint16_t)CAN->Page.RxFIFO.MTSRH << 8) | CAN->Page.RxFIFO.MTSRL);
+#endif /* CAN_STATISTICS_SUPPORT */
+}
+
+#endif /* CAN_RX_FIFO_SUPPORT */
+
+#if defined (CAN_RX_FIFO_SUPPORT) || defined (CAN_TX_QUEUE_SUPPORT)
+/**
+  * @brief  Copies a frame; only the DLC first data bytes are copied.
+  * @param   Destination: frame written.
+  * @param   Source: frame read.
+  * @retval None
+  */
+static void CAN_CopyFrame(CAN_Frame_TypeDef* Destination, const CAN_Frame_TypeDef* Source)
+{
+  uint8_t i = 0;
+
+  Destination->Id = Source->Id;
+  Destination->IDE = Source->IDE;
+  Destination->RTR = Source->RTR;
+  Destination->DLC = Source->DLC;
+  Destination->FMI = Source->FMI;
+  for (i = 0; i < Source->DLC; i++)
+  {
+    Destination->Data[i] = Source->Data[i];
+  }
+#if defined (CAN_STATISTICS_SUPPORT)
+  Destination->TimeStamp = Source->TimeStamp;
+#endif /* CAN_STATISTICS_SUPPORT */
+}
+#endif /* CAN_RX_FIFO_SUPPORT || CAN_TX_QUEUE_SUPPORT */
+
+#if defined (CAN_TX_QUEUE_SUPPORT)
+/**
+  * @brief  Computes the arbitration key of a frame, the lowest key winning
+  *         the bus arbitration: base identifier, RTR/SRR, IDE, identifier
+  *         extension then RTR of the extended frames.
+  * @param   CAN_Frame: frame to be sent.
+  * @retval The arbitration key.
+  */
+static uint32_t CAN_GetArbitrationKey(const CAN_Frame_TypeDef* CAN_Frame)
+{
+  uint32_t key = 0;
+
+  if (CAN_Frame->IDE != CAN_Id_Standard)
+  {
+    key = ((CAN_Frame->Id >> 18) << 21) | ((uint32_t)0x3 << 19) | ((CAN_Frame->Id & 0x3FFFF) << 1);
+    if (CAN_Frame->RTR != CAN_RTR_Data)
+    {
+      key |= 0x1;
+    }
+  }
+  else
+  {
+    key = (uint32_t)CAN_Frame->Id << 21;
+    if (CAN_Frame->RTR != CAN_RTR_Data)
+    {
+      key |= ((uint32_t)0x1 << 20);
+    }
+  }
+  return key;
+}
+
+/**
+  * @brief  Writes a frame in an empty transmit mailbox and requests its
+  *         transmission; only the DLC first data bytes are written.
+  * @param   CAN_Frame: frame to be sent.
+  * @par Required preconditions:
+  * The selected page is restored by the caller.
+  * @retval ERROR if no mailbox is empty.
+  */
+static ErrorStatus CAN_LoadMailbox(const CAN_Frame_TypeDef* CAN_Frame)
+{
+  uint32_t id = CAN_Frame->Id;
+  uint8_t i = 0;
+  __IO uint8_t* data = 0;
+
+  /* Select one empty transmit mailbox */
+  if ((CAN->TPR & CAN_TPR_TME0) != 0)
+  {
+    CAN->PSR = CAN_Page_TxMailBox0;
+  }
+  else if ((CAN->TPR & CAN_TPR_TME1) != 0)
+  {
+    CAN->PSR = CAN_Page_TxMailBox1;
+  }
+  else if ((CAN->TPR & CAN_TPR_TME2) != 0)
+  {
+    CAN->PSR = CAN_Page_TxMailBox2;
+  }
+  else
+  {
+    return ERROR;
+  }
+
+  /* Set up the Id */
+  if (CAN_Frame->IDE != CAN_Id_Standard)
+  {
+    CAN->Page.TxMailbox.MIDR4 = (uint8_t)(id);
+    CAN->Page.TxMailbox.MIDR3 = (uint8_t)(id >> 8);
+    CAN->Page.TxMailbox.MIDR2 = (uint8_t)(id >> 16);
+    CAN->Page.TxMailbox.MIDR1 = (uint8_t)((uint8_t)((uint8_t)(id >> 24) & 0x1F) | CAN_Id_Extended | CAN_Frame->RTR);
+  }
+  else
+  {
+    CAN->Page.TxMailbox.MIDR1 = (uint8_t)((uint8_t)((uint16_t)id >> 6) | CAN_Frame->RTR);
+    CAN->Page.TxMailbox.MIDR2 = (uint8_t)((uint16_t)id << 2);
+  }
+
+  /* Set up the DLC and the DLC first data bytes */
+  CAN->Page.TxMailbox.MDLCR = (uint8_t)((uint8_t)(CAN->Page.TxMailbox.MDLCR & (uint8_t)0xF0) | CAN_Frame->DLC);
+  data = &CAN->Page.TxMailbox.MDAR1;
+  for (i = 0; i < CAN_Frame->DLC; i++)
+  {
+    data[i] = CAN_Frame->Data[i];
+  }
+
+  /* Request transmission */
+  CAN->Page.TxMailbox.MCSR |= CAN_MCSR_TXRQ;
+
+  return SUCCESS;
+}
+#endif /* CAN_TX_QUEUE_SUPPORT */
+
+#if defined (CAN_FILTER_PLAN_SUPPORT)
+/**
+  * @brief  Counts the bits set in a value.
+  * @param   Value: value to look at.
+  * @retval Number of bits set
+  */
+static uint8_t CAN_CountBits(uint32_t Value)
+{
+  uint8_t bits = 0;
+  
+  while (Value != 0)
+  {
+    Value &= Value - 1;
+    bits++;
+  }
+  return bits;
+}
+
+/**
+  * @brief  Joins two identifier blocks of the same type in the first one and
+  *         moves the last block in place of the second one.
+  * @param   Blocks: identifier blocks.
+  * @param   Count: number of blocks.
+  * @param   Lossless: TRUE to join only a block with a block containing it
+  *         or with its aligned neighbour, FALSE to join the two blocks adding
+  *         the fewest identifiers.
+  * @retval SUCCESS when two blocks are joined, ERROR otherwise
+  */
+static ErrorStatus CAN_MergeFilterBlocks(CAN_FilterBlock_TypeDef* Blocks, uint8_t Count, bool Lossless)
+{
+  uint32_t care = 0;
+  uint32_t full = 0;
+  uint8_t span = 0;
+  uint8_t best = 0xFF;
+  uint8_t first = 0;
+  uint8_t second = 0;
+  uint8_t i = 0;
+  uint8_t j = 0;
+  
+  for (i = 0; i < Count; i++)
+  {
+    if (Blocks[i].IDE != CAN_Id_Standard)
+    {
+      full = CAN_EXTID_SIZE;
+    }
+    else
+    {
+      full = CAN_STDID_SIZE;
+    }
+    for (j = (uint8_t)(i + 1); j < Count; j++)
+    {
+      if (Blocks[j].IDE == Blocks[i].IDE)
+      {
+        care = Blocks[i].Care & Blocks[j].Care & ~(Blocks[i].Id ^ Blocks[j].Id);
+        if (Lossless != FALSE)
+        {
+          if ((care == Blocks[i].Care) || (care == Blocks[j].Care) ||
+              ((Blocks[i].Care == Blocks[j].Care) && (CAN_CountBits(care ^ Blocks[i].Care) == 1)))
+          {
+            best = 0;
+            first = i;
+            second = j;
+          }
+        }
+        else
+        {
+          /* log2 of the number of identifiers in the joined block */
+          span = CAN_CountBits(full & ~care);
+          if (span < best)
+          {
+            best = span;
+            first = i;
+            second = j;
+          }
+        }
+      }
+    }
+  }
+  
+  if (best == 0xFF)
+  {
+    return ERROR;
+  }
+  
+  care = Blocks[first].Care & Blocks[second].Care & ~(Blocks[first].Id ^ Blocks[second].Id);
+  Blocks[first].Care = care;
+  Blocks[first].Id &= care;
+  Blocks[second] = Blocks[Count - 1];
+  
+  return SUCCESS;
+}
+
+/**
+  * @brief  Gets the cheapest filter kind able to hold an identifier block.
+  * @param   Block: identifier block.
+  * @param   Scale8: ENABLE to allow the 8-bit filters.
+  * @retval Filter kind (CAN_FILTER_KIND_xxx)
+  */
+static uint8_t CAN_GetFilterKind(const CAN_FilterBlock_TypeDef* Block, FunctionalState Scale8)
+{
+  uint8_t kind = CAN_FILTER_KIND_MASK16;
+  
+  if (Block->IDE != CAN_Id_Standard)
+  {
+    if (Block->Care == CAN_EXTID_SIZE)
+    {
+      kind = CAN_FILTER_KIND_LIST32;
+    }
+    else if ((Block->Care & (uint32_t)0x7FFF) != 0)
+    {
+      /* EXID[14:0] are only in the 32-bit filters */
+      kind = CAN_FILTER_KIND_MASK32;
+    }
+  }
+  else if (Block->Care == CAN_STDID_SIZE)
+  {
+    kind = CAN_FILTER_KIND_LIST16;
+  }
+  else if ((Scale8 != DISABLE) && ((Block->Care & (uint32_t)0x07) == 0))
+  {
+    if (Block->Care == ((uint32_t)CAN_STDID_SIZE & ~(uint32_t)0x07))
+    {
+      kind = CAN_FILTER_KIND_LIST8;
+    }
+    else
+    {
+      kind = CAN_FILTER_KIND_MASK8;
+    }
+  }
+  return kind;
+}
+
+/**
+  * @brief  Computes the number of filter banks needed by identifier blocks.
+  * @param   Blocks: identifier blocks.
+  * @param   Count: number of blocks.
+  * @param   Scale8: ENABLE to allow the 8-bit filters.
+  * @retval Number of filter banks
+  */
+static uint8_t CAN_GetFilterBankCount(const CAN_FilterBlock_TypeDef* Blocks, uint8_t Count, FunctionalState Scale8)
+{
+  uint8_t kinds[CAN_FILTER_KINDS] = {0, 0, 0, 0, 0, 0};
+  uint8_t halves = 0;
+  uint8_t slots = 0;
+  uint8_t kind = 0;
+  uint8_t i = 0;
+  
+  for (i = 0; i < Count; i++)
+  {
+    kinds[CAN_GetFilterKind(&Blocks[i], Scale8)]++;
+  }
+  for (kind = CAN_FILTER_KIND_LIST16; kind < CAN_FILTER_KINDS; kind++)
+  {
+    /* Half bank of 4 bytes: one identifier (list) or identifier and mask */
+    slots = (uint8_t)(4 / CAN_FilterWidths[kind]);
+    if ((kind & 0x01) != 0)
+    {
+      slots >>= 1;
+    }
+    halves += (uint8_t)((uint8_t)(kinds[kind] + slots - 1) / slots);
+  }
+  return (uint8_t)(kinds[CAN_FILTER_KIND_MASK32] + (uint8_t)((uint8_t)(kinds[CAN_FILTER_KIND_LIST32] + 1) >> 1) +
+                   (uint8_t)((uint8_t)(halves + 1) >> 1));
+}
+
+/**
+  * @brief  Encodes an identifier or a mask in the filter register layout:
+  *         STID[10:3], STID[2:0] RTR IDE EXID[17:15], EXID[14:7], EXID[6:0].
+  * @param   Bytes: receives the Width bytes.
+  * @param   Value: identifier or mask.
+  * @param   IDE: Value type, one of @ref CAN_Id_TypeDef.
+  * @param   Width: number of bytes, 1, 2 or 4.
+  * @param   Flags: RTR and IDE bits of the second byte.
+  * @retval None
+  */
+static void CAN_EncodeFilterBytes(uint8_t* Bytes, uint32_t Value, uint8_t IDE, uint8_t Width, uint8_t Flags)
+{
+  uint16_t stid = (uint16_t)Value;
+  
+  if (IDE != CAN_Id_Standard)
+  {
+    stid = (uint16_t)(Value >> 18);
+  }
+  Bytes[0] = (uint8_t)(stid >> 3);
+  if (Width != 1)
+  {
+    Bytes[1] = (uint8_t)((uint8_t)((uint8_t)stid << 5) | Flags);
+    if (IDE != CAN_Id_Standard)
+    {
+      Bytes[1] |= (uint8_t)((uint8_t)(Value >> 15) & (uint8_t)0x07);
+    }
+    if (Width == 4)
+    {
+      Bytes[2] = (uint8_t)(Value >> 7);
+      Bytes[3] = (uint8_t)((uint8_t)Value << 1);
+    }
+  }
+}
+
+/**
+  * @brief  Programs and activates a filter bank.
+  * @param   Number: filter bank number, 0 to 5.
+  * @param   LowWidth: identifier bytes of the first half, 1, 2 or 4.
+  * @param   HighWidth: identifier bytes of the second half, 1, 2 or 4.
+  * @param   Lists: bit 0 (resp. 1) set when the first (resp. second) half
+  *         is in identifier list mode.
+  * @param   Bytes: the 8 filter registers values.
+  * @retval None
+  */
+static void CAN_SetFilterBank(uint8_t Number, uint8_t LowWidth, uint8_t HighWidth, uint8_t Lists, const uint8_t* Bytes)
+{
+  CAN_FilterMode_TypeDef mode = CAN_FilterMode_IdMask;
+  
+  if (Lists == 0x03)
+  {
+    mode = CAN_FilterMode_IdList;
+  }
+  else if (Lists == 0x01)
+  {
+    mode = CAN_FilterMode_IdList_IdMask;
+  }
+  else if (Lists == 0x02)
+  {
+    mode = CAN_FilterMode_IdMask_IdList;
+  }
+  
+  /* CAN_FilterInit() parameters are in the register order of each scale */
+  if (LowWidth == 4)
+  {
+    CAN_FilterInit((CAN_FilterNumber_TypeDef)Number, ENABLE, mode, CAN_FilterScale_32Bit,
+                   Bytes[0], Bytes[1], Bytes[2], Bytes[3], Bytes[4], Bytes[5], Bytes[6], Bytes[7]);
+  }
+  else if (LowWidth == 1)
+  {
+    CAN_FilterInit((CAN_FilterNumber_TypeDef)Number, ENABLE, mode, CAN_FilterScale_8Bit,
+                   Bytes[0], Bytes[2], Bytes[4], Bytes[6], Bytes[1], Bytes[3], Bytes[5], Bytes[7]);
+  }
+  else if (HighWidth == 1)
+  {
+    CAN_FilterInit((CAN_FilterNumber_TypeDef)Number, ENABLE, mode, CAN_FilterScale_16_8Bit,
+                   Bytes[0], Bytes[1], Bytes[4], Bytes[6], Bytes[2], Bytes[3], Bytes[5], Bytes[7]);
+  }
+  else
+  {
+    CAN_FilterInit((CAN_FilterNumber_TypeDef)Number, ENABLE, mode, CAN_FilterScale_16Bit,
+                   Bytes[0], Bytes[1], Bytes[4], Bytes[5], Bytes[2], Bytes[3], Bytes[6], Bytes[7]);
+  }
+}
+
+/**
+  * @brief  Programs the filter banks from identifier blocks: 32-bit filters
+  *         first, then pairs of 16-bit halves, a 16/8-bit bank, pairs of
+  *         8-bit halves; the free slots of a filter repeat its first one.
+  * @param   Blocks: identifier blocks, fitting in the filter banks.
+  * @param   Count: number of blocks.
+  * @param   Scale8: ENABLE to allow the 8-bit filters.
+  * @retval None
+  */
+static void CAN_ProgramFilterPlan(const CAN_FilterBlock_TypeDef* Blocks, uint8_t Count, FunctionalState Scale8)
+{
+  uint8_t bytes[8];
+  uint8_t widths[2] = {0, 0};
+  uint8_t lists = 0;
+  uint8_t half = 0;
+  uint8_t number = 0;
+  uint8_t kind = 0;
+  uint8_t width = 0;
+  uint8_t entry = 0;
+  uint8_t unit = 0;
+  uint8_t slot = 0;
+  uint8_t offset = 0;
+  uint8_t i = 0;
+  
+  for (kind = 0; kind < CAN_FILTER_KINDS; kind++)
+  {
+    width = CAN_FilterWidths[kind];
+    /* Bytes of a filter entry, and of the bank or half bank filled */
+    entry = width;
+    if ((kind & 0x01) != 0)
+    {
+      entry <<= 1;
+    }
+    unit = 4;
+    if (width == 4)
+    {
+      unit = 8;
+    }
+    
+    slot = 0;
+    for (i = 0; i <= Count; i++)
+    {
+      offset = (uint8_t)((uint8_t)(half << 2) + (uint8_t)(slot * entry));
+      if (i < Count)
+      {
+        if (CAN_GetFilterKind(&Blocks[i], Scale8) != kind)
+        {
+          continue;
+        }
+        if (Blocks[i].IDE != CAN_Id_Standard)
+        {
+          CAN_EncodeFilterBytes(&bytes[offset], Blocks[i].Id, Blocks[i].IDE, width, CAN_FILTER_IDE);
+        }
+        else
+        {
+          CAN_EncodeFilterBytes(&bytes[offset], Blocks[i].Id, Blocks[i].IDE, width, 0);
+        }
+        if ((kind & 0x01) != 0)
+        {
+          /* Mask: care about IDE, not about RTR */
+          CAN_EncodeFilterBytes(&bytes[offset + width], Blocks[i].Care, Blocks[i].IDE, width, CAN_FILTER_IDE);
+        }
+        slot++;
+        if ((uint8_t)(slot * entry) < unit)
+        {
+          continue;
+        }
+      }
+      else if (slot == 0)
+      {
+        break;
+      }
+      else
+      {
+        /* Repeat the first entry in the free slots */
+        for (; (uint8_t)(offset - (uint8_t)(half << 2)) < unit; offset++)
+        {
+          bytes[offset] = bytes[offset - entry];
+        }
+      }
+      
+      slot = 0;
+      if (width == 4)
+      {
+        CAN_SetFilterBank(number, 4, 4, (uint8_t)((kind == CAN_FILTER_KIND_LIST32) ? 0x03 : 0x00), bytes);
+        number++;
+      }
+      else
+      {
+        widths[half] = width;
+        if ((kind & 0x01) == 0)
+        {
+          lists |= (uint8_t)(half + 1);
+        }
+        half ^= 1;
+        if (half == 0)
+        {
+          CAN_SetFilterBank(number, widths[0], widths[1], lists, bytes);
+          number++;
+          lists = 0;
+        }
+      }
+    }
+  }
+  
+  if (half != 0)
+  {
+    /* Last half bank alone: repeated in the second half */
+    for (i = 0; i < 4; i++)
+    {
+      bytes[i + 4] = bytes[i];
+    }
+    CAN_SetFilterBank(number, widths[0], widths[0], (uint8_t)(lists * 3), bytes);
+    number++;
+  }
+  
+  /* Deactivate the unused filter banks */
+  for (; number < CAN_FILTER_BANKS; number++)
+  {
+    CAN_FilterInit((CAN_FilterNumber_TypeDef)number, DISABLE, CAN_FilterMode_IdMask, CAN_FilterScale_32Bit,
+                   0, 0, 0, 0, 0, 0, 0, 0);
+  }
+}
+#endif /* CAN_FILTER_PLAN_SUPPORT */
+
+#if defined (CAN_STATISTICS_SUPPORT)
+/**
+  * @brief  Adds a frame to the bus load window; the load is computed once
+  *         the window reaches CAN_LOAD_WINDOW bit times.
+  * @param   TimeStamp: time stamp of the frame.
+  * @param   IDE: identifier type, one of @ref CAN_Id_TypeDef.
+  * @param   RTR: frame type, one of @ref CAN_RTR_TypeDef.
+  * @param   DLC: data length code.
+  * @note   The time stamp counter wraps every 65536 bit times: longer
+  *         silences are under-counted and the load over-estimated.
+  * @retval None
+  */
+static void CAN_RecordLoad(uint16_t TimeStamp, uint8_t IDE, uint8_t RTR, uint8_t DLC)
+{
+  uint16_t elapsed = 0;
+  uint8_t bits = CAN_FRAME_BITS_STD;
+  
+  if (IDE != CAN_Id_Standard)
+  {
+    bits = CAN_FRAME_BITS_EXT;
+  }
+  if ((RTR == CAN_RTR_Data) && (DLC <= CAN_DLC_MAX))
+  {
+    bits += (uint8_t)(DLC << 3);
+  }
+  
+  if (CAN_StatsStarted != FALSE)
+  {
+    elapsed = (uint16_t)(TimeStamp - CAN_StatsStamp);
+    /* A frame recorded late (RX and TX interrupts) adds no time */
+    if (elapsed < (uint16_t)0x8000)
+    {
+      CAN_StatsStamp = TimeStamp;
+      CAN_LoadTime += elapsed;
+    }
+  }
+  else
+  {
+    CAN_StatsStamp = TimeStamp;
+    CAN_StatsStarted = TRUE;
+  }
+  CAN_LoadBits += bits;
+  
+  if (CAN_LoadTime >= CAN_LOAD_WINDOW)
+  {
+    if (CAN_LoadBits >= CAN_LoadTime)
+    {
+      CAN_Stats.Load = 100;
+    }
+    else
+    {
+      CAN_Stats.Load = (uint8_t)((CAN_LoadBits * 100) / CAN_LoadTime);
+    }
+    CAN_LoadBits = 0;
+    CAN_LoadTime = 0;
+  }
+}
+
+/**
+  * @brief  Records a received frame: counters, bus load and statistics of
+  *         its identifier (mean period and jitter, smoothed over 8 frames).
+  * @param   CAN_Frame: frame received, time stamp set.
+  * @retval None
+  */
+static void CAN_RecordRxFrame(const CAN_Frame_TypeDef* CAN_Frame)
+{
+  CAN_IdStatistics_TypeDef* stats = 0;
+  uint16_t interval = 0;
+  uint16_t deviation = 0;
+  uint8_t i = 0;
+  
+  CAN_Stats.RxFrames++;
+  CAN_RecordLoad(CAN_Frame->TimeStamp, CAN_Frame->IDE, CAN_Frame->RTR, CAN_Frame->DLC);
+  
+  for (i = 0; i < CAN_Stats.IdCount; i++)
+  {
+    if ((CAN_Stats.Ids[i].Id == CAN_Frame->Id) && (CAN_Stats.Ids[i].IDE == CAN_Frame->IDE))
+    {
+      break;
+    }
+  }
+  if (i == CAN_Stats.IdCount)
+  {
+    if (i == (uint8_t)CAN_STATISTICS_IDS)
+    {
+      if (CAN_Stats.OtherFrames != 0xFFFF)
+      {
+        CAN_Stats.OtherFrames++;
+      }
+      return;
+    }
+    CAN_Stats.Ids[i].Id = CAN_Frame->Id;
+    CAN_Stats.Ids[i].IDE = CAN_Frame->IDE;
+    CAN_Stats.Ids[i].Count = 0;
+    CAN_Stats.Ids[i].Period = 0;
+    CAN_Stats.Ids[i].Jitter = 0;
+    CAN_Stats.IdCount++;
+  }
+  stats = &CAN_Stats.Ids[i];
+  
+  interval = (uint16_t)(CAN_Frame->TimeStamp - stats->TimeStamp);
+  stats->TimeStamp = CAN_Frame->TimeStamp;
+  if (stats->Count == 1)
+  {
+    stats->Period = interval;
+  }
+  else if (stats->Count > 1)
+  {
+    if (interval > stats->Period)
+    {
+      deviation = (uint16_t)(interval - stats->Period);
+      stats->Period += (uint16_t)(deviation >> 3);
+    }
+    else
+    {
+      deviation = (uint16_t)(stats->Period - interval);
+      stats->Period -= (uint16_t)(deviation >> 3);
+    }
+    if (deviation > stats->Jitter)
+    {
+      stats->Jitter += (uint16_t)((uint16_t)(deviation - stats->Jitter) >> 3);
+    }
+    else
+    {
+      stats->Jitter -= (uint16_t)((uint16_t)(stats->Jitter - deviation) >> 3);
+    }
+  }
+  if (stats->Count != 0xFFFF)
+  {
+    stats->Count++;
   }
-  return (ITStatus)pendingbitstatus;
 }
+#endif /* CAN_STATISTICS_SUPPORT */
 
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
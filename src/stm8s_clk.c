@@ -36,6 +36,13 @@
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/* Clock tree frequencies in Hz, computed by CLK_UpdateClockFreq() (0 = not
+   computed yet) */
+static uint32_t CLK_MasterFreq = 0;
+static uint32_t CLK_CPUFreq = 0;
+static uint32_t CLK_HSEFreq = HSE_VALUE;
+/* Clock change notifications */
+static CLK_FreqChangeCallback_TypeDef CLK_FreqCallbacks[CLK_FREQ_CALLBACKS];
 /* Private function prototypes -----------------------------------------------*/
 
 /* Private Constants ---------------------------------------------------------*/
@@ -85,6 +92,8 @@ void CLK_DeInit(void)
   CLK->CCOR = CLK_CCOR_RESET_VALUE;
   CLK->HSITRIMR = CLK_HSITRIMR_RESET_VALUE;
   CLK->SWIMCCR = CLK_SWIMCCR_RESET_VALUE;
+  
+  CLK_UpdateClockFreq();
 }
 
 /**
@@ -208,10 +217,16 @@ void CLK_CCOCmd(FunctionalState NewState)
   * @par Full description:
   * NewState parameter set the SWEN.
   * @param   NewState new state of SWEN, value accepted ENABLE, DISABLE.
+  * @note   On ENABLE, the clock tree frequencies are refreshed once the
+  *         switch is done (SWBSY cleared). If it is not done within
+  *         CLK_TIMEOUT loops, CLK_UpdateClockFreq() must be called from the
+  *         clock switch interrupt routine.
   * @retval None
   */
 void CLK_ClockSwitchCmd(FunctionalState NewState)
 {
+  uint16_t DownCounter = CLK_TIMEOUT;
+  
   /* Check the parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
@@ -219,6 +234,16 @@ void CLK_ClockSwitchCmd(FunctionalState NewState)
   {
     /* Enable the Clock Switch */
     CLK->SWCR |= CLK_SWCR_SWEN;
+    
+    /* Wait for the switch to be done before refreshing the frequencies */
+    while (((CLK->SWCR & CLK_SWCR_SWBSY) != 0) && (DownCounter != 0))
+    {
+      DownCounter--;
+    }
+    if ((CLK->SWCR & CLK_SWCR_SWBSY) == 0)
+    {
+      CLK_UpdateClockFreq();
+    }
   }
   else
   {
@@ -304,6 +329,10 @@ void CLK_PeripheralClockConfig(CLK_Peripheral_TypeDef CLK_Peripheral, Functional
   * @param   CLK_CurrentClockState current clock to switch OFF or to keep ON.
   * It can be set of the values of @ref CLK_CurrentClockState_TypeDef
   * @note LSI selected as master clock source only if LSI_EN option bit is set.
+  * @note The clock tree frequencies are refreshed once the switch is done
+  *       (SWBSY cleared). If it is not done within CLK_TIMEOUT loops,
+  *       CLK_UpdateClockFreq() must be called from the clock switch
+  *       interrupt routine.
   * @retval ErrorStatus this shows the clock switch status (ERROR/SUCCESS).
   */
 ErrorStatus CLK_ClockSwitchConfig(CLK_SwitchMode_TypeDef CLK_SwitchMode, CLK_Source_TypeDef CLK_NewClock, FunctionalState ITState, CLK_CurrentClockState_TypeDef CLK_CurrentClockState)
@@ -402,6 +431,18 @@ ErrorStatus CLK_ClockSwitchConfig(CLK_SwitchMode_TypeDef CLK_SwitchMode, CLK_Sou
     {
       CLK->ECKR &= (uint8_t)(~CLK_ECKR_HSEEN);
     }
+    
+    /* Refresh the clock tree frequencies once the switch is done: in manual
+       mode it starts when SWEN is set above */
+    DownCounter = CLK_TIMEOUT;
+    while (((CLK->SWCR & CLK_SWCR_SWBSY) != 0) && (DownCounter != 0))
+    {
+      DownCounter--;
+    }
+    if ((CLK->SWCR & CLK_SWCR_SWBSY) == 0)
+    {
+      CLK_UpdateClockFreq();
+    }
   }
   return(Swif);
 }
@@ -422,6 +463,8 @@ void CLK_HSIPrescalerConfig(CLK_Prescaler_TypeDef HSIPrescaler)
   
   /* Set High speed internal clock prescaler */
   CLK->CKDIVR |= (uint8_t)HSIPrescaler;
+  
+  CLK_UpdateClockFreq();
 }
 
 /**
@@ -512,6 +555,8 @@ void CLK_SYSCLKConfig(CLK_Prescaler_TypeDef CLK_Prescaler)
     CLK->CKDIVR &= (uint8_t)(~CLK_CKDIVR_CPUDIV);
     CLK->CKDIVR |= (uint8_t)((uint8_t)CLK_Prescaler & (uint8_t)CLK_CKDIVR_CPUDIV);
   }
+  
+  CLK_UpdateClockFreq();
 }
 
 /**
@@ -562,13 +607,52 @@ CLK_Source_TypeDef CLK_GetSYSCLKSource(void)
 }
 
 /**
-  * @brief  This function returns the frequencies of different on chip clocks.
+  * @brief  This function returns the master clock frequency (fMASTER).
+  * @note   The frequency is cached: it is computed on the first call and
+  *         refreshed by the CLK functions changing the clock tree.
   * @param  None
   * @retval the master clock frequency
   */
 uint32_t CLK_GetClockFreq(void)
 {
-  uint32_t clockfrequency = 0;
+  if (CLK_MasterFreq == 0)
+  {
+    CLK_UpdateClockFreq();
+  }
+  
+  return(CLK_MasterFreq);
+}
+
+/**
+  * @brief  This function returns the CPU clock frequency (fCPU), i.e. the
+  *         master clock frequency divided by the CPU prescaler.
+  * @param  None
+  * @retval the CPU clock frequency
+  */
+uint32_t CLK_GetCPUClockFreq(void)
+{
+  if (CLK_MasterFreq == 0)
+  {
+    CLK_UpdateClockFreq();
+  }
+  
+  return(CLK_CPUFreq);
+}
+
+/**
+  * @brief  Recomputes the cached fMASTER and fCPU frequencies from the clock
+  *         registers and calls the clock change callbacks if they changed.
+  * @note   Called by CLK_DeInit(), CLK_ClockSwitchConfig(),
+  *         CLK_ClockSwitchCmd(), CLK_HSIPrescalerConfig(), CLK_SYSCLKConfig()
+  *         and CLK_HSEFreqConfig(). It must be called by the application when the
+  *         clock tree changes without these functions, e.g. in the clock
+  *         switch or clock security system interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void CLK_UpdateClockFreq(void)
+{
+  uint32_t masterfrequency = 0, cpufrequency = 0;
   CLK_Source_TypeDef clocksource = CLK_SOURCE_HSI;
   uint8_t tmp = 0;
   
@@ -579,18 +663,94 @@ uint32_t CLK_GetClockFreq(void)
   {
     tmp = (uint8_t)(CLK->CKDIVR & CLK_CKDIVR_HSIDIV);
     tmp = (uint8_t)(tmp >> 3);
-    clockfrequency = HSI_VALUE >> HSIDivExp[tmp];
+    masterfrequency = HSI_VALUE >> HSIDivExp[tmp];
   }
   else if ( clocksource == CLK_SOURCE_LSI)
   {
-    clockfrequency = LSI_VALUE;
+    masterfrequency = LSI_VALUE;
   }
   else
   {
-    clockfrequency = HSE_VALUE;
+    masterfrequency = CLK_HSEFreq;
   }
   
-  return((uint32_t)clockfrequency);
+  /* CPU prescaler: fCPU = fMASTER / 2^CPUDIV */
+  cpufrequency = masterfrequency >> (uint8_t)(CLK->CKDIVR & CLK_CKDIVR_CPUDIV);
+  
+  if ((masterfrequency != CLK_MasterFreq) || (cpufrequency != CLK_CPUFreq))
+  {
+    CLK_MasterFreq = masterfrequency;
+    CLK_CPUFreq = cpufrequency;
+    
+    /* Let the peripherals re-derive their dividers */
+    for (tmp = 0; tmp < CLK_FREQ_CALLBACKS; tmp++)
+    {
+      if (CLK_FreqCallbacks[tmp] != 0)
+      {
+        CLK_FreqCallbacks[tmp]();
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Sets the frequency of the external oscillator (HSE).
+  * @note   HSE_VALUE is used until this function is called.
+  * @param   HSEFreq frequency of the external oscillator in Hz.
+  * @retval None
+  */
+void CLK_HSEFreqConfig(uint32_t HSEFreq)
+{
+  /* check the parameters */
+  assert_param(IS_CLK_HSE_FREQ_OK(HSEFreq));
+  
+  CLK_HSEFreq = HSEFreq;
+  
+  CLK_UpdateClockFreq();
+}
+
+/**
+  * @brief  Registers or unregisters a clock change callback.
+  * @note   The callbacks are called by CLK_UpdateClockFreq() once the cached
+  *         fMASTER or fCPU frequency changed, possibly from an interrupt.
+  * @param   Callback function to call after a clock change.
+  * @param   NewState ENABLE to register the callback, DISABLE to unregister it.
+  * @retval ErrorStatus ERROR when no room is left for a new callback
+  *         (see CLK_FREQ_CALLBACKS), SUCCESS otherwise.
+  */
+ErrorStatus CLK_FreqChangeCallbackCmd(CLK_FreqChangeCallback_TypeDef Callback, FunctionalState NewState)
+{
+  uint8_t i = 0, slot = CLK_FREQ_CALLBACKS;
+  
+  /* check the parameters */
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  assert_param(Callback != 0);
+  
+  for (i = 0; i < CLK_FREQ_CALLBACKS; i++)
+  {
+    if (CLK_FreqCallbacks[i] == Callback)
+    {
+      if (NewState == DISABLE)
+      {
+        CLK_FreqCallbacks[i] = 0;
+      }
+      return(SUCCESS);
+    }
+    if ((CLK_FreqCallbacks[i] == 0) && (slot == CLK_FREQ_CALLBACKS))
+    {
+      slot = i;
+    }
+  }
+  
+  if (NewState != DISABLE)
+  {
+    if (slot == CLK_FREQ_CALLBACKS)
+    {
+      return(ERROR);
+    }
+    CLK_FreqCallbacks[slot] = Callback;
+  }
+  return(SUCCESS);
 }
 
 /**
@@ -49,9 +49,510 @@
   */
 
 /* Private macro -------------------------------------------------------------*/
+#if defined (I2C_TRANSFER_SUPPORT)
+#if !IS_I2C_TRANSFER_QUEUE_SIZE_OK(I2C_TRANSFER_QUEUE_SIZE)
+ #error "I2C_TRANSFER_QUEUE_SIZE must be a power of two between 2 and 128"
+#endif
+#endif /* I2C_TRANSFER_SUPPORT */
+
 /* Private variables ---------------------------------------------------------*/
+#if defined (I2C_TIMEOUT_SUPPORT)
+static I2C_GetTick_TypeDef I2C_GetTick = 0;      /* Tick source, 0 to count polls */
+static uint16_t I2C_Timeout = I2C_DEFAULT_TIMEOUT; /* Timeout of the waits in ticks */
+static uint16_t I2C_PollCount = 0;               /* Tick source by default */
+#endif /* I2C_TIMEOUT_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT)
+static I2C_Transfer_TypeDef* volatile I2C_Transfer = 0; /* Transfer in progress */
+static uint8_t I2C_Count = 0;       /* Bytes left in the current phase */
+static uint8_t I2C_Index = 0;       /* Next byte of the current phase */
+static bool I2C_Receiving = FALSE;  /* Read phase of the current transfer */
+/* Transfers waiting behind the one in progress, head and tail run freely */
+static I2C_Transfer_TypeDef* I2C_Queue[I2C_TRANSFER_QUEUE_SIZE];
+static uint8_t I2C_QueueHead = 0;   /* Written by I2C_QueueTransfer() */
+static uint8_t I2C_QueueTail = 0;   /* Written when a transfer ends */
+static bool I2C_QueueRunning = FALSE; /* Set while I2C_QueueNext() runs */
+#endif /* I2C_TRANSFER_SUPPORT */
+
+#if defined (I2C_SLAVE_SUPPORT)
+static uint8_t* I2C_SlaveMap = 0;           /* Register map, 0 when not configured */
+static const uint8_t* I2C_SlaveMask = 0;    /* Writable bits of each register */
+static uint8_t I2C_SlaveSize = 0;           /* Number of registers */
+static I2C_SlaveCallback_TypeDef I2C_SlaveCallback = 0;
+static uint8_t I2C_SlavePointer = 0;        /* Register pointer */
+static uint8_t I2C_SlaveFirst = 0;          /* First register of the current write */
+static uint8_t I2C_SlaveCount = 0;          /* Registers written by the current write */
+static bool I2C_SlaveEnabled = FALSE;       /* Set by I2C_SlaveCmd() */
+static bool I2C_SlaveActive = FALSE;        /* Own address accessed, until STOP or NACK */
+static bool I2C_SlaveRegisterByte = FALSE;  /* Next byte received sets the pointer */
+#endif /* I2C_SLAVE_SUPPORT */
+
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
+#if defined (I2C_TIMEOUT_SUPPORT)
+/**
+  * @brief  Reads the tick source of the timeouts; without tick source each
+  *         call counts as one tick.
+  * @param  None
+  * @retval uint16_t : current tick
+  */
+static uint16_t I2C_GetTickNow(void)
+{
+  if (I2C_GetTick != 0)
+  {
+    return I2C_GetTick();
+  }
+  return ++I2C_PollCount;
+}
+
+/**
+  * @brief  Checks whether the timeout has elapsed since a given tick.
+  * @param  Start : tick read by I2C_GetTickNow() when the wait started
+  * @retval bool : TRUE once the timeout has elapsed
+  */
+static bool I2C_TimeoutElapsed(uint16_t Start)
+{
+  return (((uint16_t)(I2C_GetTickNow() - Start) >= I2C_Timeout) ? TRUE : FALSE);
+}
+
+/**
+  * @brief  Waits for about a quarter of a 100 kHz SCL period.
+  * @param  Loops : loops of the wait, computed from fCPU
+  * @retval None
+  */
+static void I2C_RecoveryDelay(uint8_t Loops)
+{
+  while (Loops != 0)
+  {
+    Loops--;
+    nop();
+  }
+}
+#endif /* I2C_TIMEOUT_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT)
+/**
+  * @brief  Waits for the STOP condition requested at the end of the previous
+  *         transfer to be sent. No event is raised in master mode once it is
+  *         sent (STOPF is a slave flag), so the wait is bounded by the bus
+  *         clock: 16 x CCR loops of 4 cycles at least, more than two SCL
+  *         periods in all the modes. It is sent within one SCL period on a
+  *         free bus.
+  * @param  None
+  * @retval bool : FALSE if STOP is still pending (SCL held low).
+  */
+static bool I2C_WaitStopSent(void)
+{
+  uint16_t loops = 0;
+
+  loops = (uint16_t)((uint16_t)((uint16_t)((uint16_t)(I2C->CCRH & I2C_CCRH_CCR) << 8) | I2C->CCRL) << 4);
+  while ((I2C->CR2 & I2C_CR2_STOP) != 0)
+  {
+    if (loops == 0)
+    {
+      return FALSE;
+    }
+    loops--;
+  }
+  return TRUE;
+}
+
+/**
+  * @brief  Starts the oldest queued transfer when the engine is free. On a
+  *         stuck bus the queued transfers are failed one after another, in a
+  *         loop and without waiting again, at most as many as were queued on
+  *         entry: the transfers queued again by their callbacks stay queued.
+  * @param  None
+  * @retval None
+  */
+static void I2C_QueueNext(void)
+{
+  I2C_Transfer_TypeDef* next = 0;
+  uint8_t left = (uint8_t)(I2C_QueueHead - I2C_QueueTail);
+  bool stuck = FALSE;
+
+  I2C_QueueRunning = TRUE;
+  /* Unless a callback already started a transfer of its own */
+  while ((I2C_Transfer == 0) && (left != 0) && (I2C_QueueHead != I2C_QueueTail))
+  {
+    next = I2C_Queue[I2C_QueueTail & (uint8_t)(I2C_TRANSFER_QUEUE_SIZE - 1)];
+    I2C_QueueTail++;
+    left--;
+    if ((stuck == FALSE) && (I2C_MasterTransfer(next) != ERROR))
+    {
+      break;
+    }
+    stuck = TRUE;
+    next->Status = I2C_TRANSFER_ERROR;
+    if (next->Callback != 0)
+    {
+      next->Callback(next);
+    }
+  }
+  I2C_QueueRunning = FALSE;
+}
+
+/**
+  * @brief  Ends the transfer in progress: disables the I2C interrupts, frees
+  *         the engine, reports the status to the transfer owner, then starts
+  *         the next queued transfer without leaving the interrupt.
+  * @param  Status : final status of the transfer
+  * @retval None
+  */
+static void I2C_TransferEnd(I2C_TransferStatus_TypeDef Status)
+{
+  I2C_Transfer_TypeDef* transfer = I2C_Transfer;
+
+  I2C->ITR &= (uint8_t)(~(I2C_ITR_ITBUFEN | I2C_ITR_ITEVTEN | I2C_ITR_ITERREN));
+  I2C->CR2 &= (uint8_t)(~I2C_CR2_POS);
+  I2C_Transfer = 0;
+#if defined (I2C_SLAVE_SUPPORT)
+  if (I2C_SlaveEnabled != FALSE)
+  {
+    /* Listen to the own address again */
+    I2C_SlaveCmd(ENABLE);
+  }
+#endif /* I2C_SLAVE_SUPPORT */
+
+  /* The engine is free again, so the callback may start the next transfer */
+  transfer->Status = Status;
+  if (transfer->Callback != 0)
+  {
+    transfer->Callback(transfer);
+  }
+
+  if (I2C_QueueRunning == FALSE)
+  {
+    I2C_QueueNext();
+  }
+}
+
+/**
+  * @brief  Starts the read phase of the current transfer (START or repeated
+  *         START with ACK enabled).
+  * @param  None
+  * @retval None
+  */
+static void I2C_StartReceive(void)
+{
+  I2C_Receiving = TRUE;
+  I2C_Count = I2C_Transfer->RxLength;
+  I2C_Index = 0;
+  I2C->CR2 |= (uint8_t)(I2C_CR2_ACK | I2C_CR2_START);
+}
+
+/**
+  * @brief  Handles the end of the write phase (BTF, or ADDR when nothing
+  *         has to be written): repeated START for the read phase or STOP.
+  * @param  None
+  * @retval None
+  */
+static void I2C_TransmitEnd(void)
+{
+  if (I2C_Transfer->RxLength != 0)
+  {
+    I2C_StartReceive();
+  }
+  else
+  {
+    I2C->CR2 |= I2C_CR2_STOP;
+    I2C_TransferEnd(I2C_TRANSFER_DONE);
+  }
+}
+
+/**
+  * @brief  Handles the ADDR event of the read phase. The acknowledge of the
+  *         last bytes is prepared here according to the number of bytes to
+  *         receive, ADDR is cleared by reading SR3 after SR1.
+  * @param  None
+  * @retval None
+  */
+static void I2C_ReceiveAddressed(void)
+{
+  if (I2C_Count == 1)
+  {
+    /* Single byte: NACK it and request STOP right after clearing ADDR */
+    I2C->CR2 &= (uint8_t)(~I2C_CR2_ACK);
+    (void)I2C->SR3;
+    I2C->CR2 |= I2C_CR2_STOP;
+    I2C->ITR |= I2C_ITR_ITBUFEN;
+  }
+  else if (I2C_Count == 2)
+  {
+    /* Two bytes: NACK applies to the second byte (POS), both are read on BTF */
+    I2C->CR2 |= I2C_CR2_POS;
+    I2C->CR2 &= (uint8_t)(~I2C_CR2_ACK);
+    (void)I2C->SR3;
+    I2C->ITR &= (uint8_t)(~I2C_ITR_ITBUFEN);
+  }
+  else
+  {
+    /* N bytes: RXNE until 3 bytes are left, then the BTF sequence */
+    (void)I2C->SR3;
+    if (I2C_Count > 3)
+    {
+      I2C->ITR |= I2C_ITR_ITBUFEN;
+    }
+    else
+    {
+      I2C->ITR &= (uint8_t)(~I2C_ITR_ITBUFEN);
+    }
+  }
+}
+
+/**
+  * @brief  Handles the RXNE and BTF events of the read phase.
+  * @param  sr1 : value read from the SR1 register
+  * @retval None
+  */
+static void I2C_ReceiveBytes(uint8_t sr1)
+{
+  uint8_t* buffer = I2C_Transfer->RxBuffer;
+
+  /* BTF is only waited for when 2 or 3 bytes are left; it may also be seen
+     earlier together with RXNE if the interrupt is served late */
+  if (((sr1 & I2C_SR1_BTF) != 0) && ((I2C_Count == 2) || (I2C_Count == 3)))
+  {
+    if (I2C_Count == 3)
+    {
+      /* DataN-2 in DR, DataN-1 in the shift register: NACK DataN */
+      I2C->CR2 &= (uint8_t)(~I2C_CR2_ACK);
+      buffer[I2C_Index++] = I2C->DR;
+      I2C_Count--;
+    }
+    else
+    {
+      /* DataN-1 in DR, DataN in the shift register */
+      I2C->CR2 |= I2C_CR2_STOP;
+      buffer[I2C_Index++] = I2C->DR;
+      buffer[I2C_Index] = I2C->DR;
+      I2C_TransferEnd(I2C_TRANSFER_DONE);
+    }
+  }
+  else if ((sr1 & I2C_SR1_RXNE) != 0)
+  {
+    buffer[I2C_Index++] = I2C->DR;
+    I2C_Count--;
+    if (I2C_Count == 0)
+    {
+      /* Single byte read, STOP already requested */
+      I2C_TransferEnd(I2C_TRANSFER_DONE);
+    }
+    else if (I2C_Count == 3)
+    {
+      I2C->ITR &= (uint8_t)(~I2C_ITR_ITBUFEN);
+    }
+  }
+}
+
+/**
+  * @brief  Handles the TXE and BTF events of the write phase.
+  * @param  sr1 : value read from the SR1 register
+  * @retval None
+  */
+static void I2C_TransmitBytes(uint8_t sr1)
+{
+  if (I2C_Count != 0)
+  {
+    if ((sr1 & I2C_SR1_TXE) != 0)
+    {
+      I2C->DR = I2C_Transfer->TxBuffer[I2C_Index++];
+      I2C_Count--;
+      if (I2C_Count == 0)
+      {
+        /* Last byte written: wait for BTF before ending the phase */
+        I2C->ITR &= (uint8_t)(~I2C_ITR_ITBUFEN);
+      }
+    }
+  }
+  else if ((sr1 & I2C_SR1_BTF) != 0)
+  {
+    I2C_TransmitEnd();
+  }
+}
+
+/**
+  * @brief  Runs the master transfer state machine.
+  * @param  None
+  * @retval None
+  */
+static void I2C_MasterEvent(void)
+{
+  uint8_t sr1 = 0, sr2 = 0;
+
+  sr2 = I2C->SR2;
+  if ((sr2 & (I2C_SR2_BERR | I2C_SR2_ARLO | I2C_SR2_AF | I2C_SR2_OVR)) != 0)
+  {
+    I2C->SR2 = 0;
+    /* The bus is released by hardware when the arbitration is lost */
+    if ((sr2 & I2C_SR2_ARLO) == 0)
+    {
+      I2C->CR2 |= I2C_CR2_STOP;
+    }
+    I2C_TransferEnd(((sr2 & I2C_SR2_AF) != 0) ? I2C_TRANSFER_NACK : I2C_TRANSFER_ERROR);
+    return;
+  }
+
+  sr1 = I2C->SR1;
+  if ((sr1 & I2C_SR1_SB) != 0)
+  {
+    /* EV5: SB is cleared by writing DR after reading SR1 */
+    I2C->DR = (uint8_t)((uint8_t)(I2C_Transfer->Address << 1) | (uint8_t)I2C_Receiving);
+  }
+  else if ((sr1 & I2C_SR1_ADDR) != 0)
+  {
+    /* EV6 */
+    if (I2C_Receiving != FALSE)
+    {
+      I2C_ReceiveAddressed();
+    }
+    else
+    {
+      (void)I2C->SR3;
+      if (I2C_Count != 0)
+      {
+        I2C->ITR |= I2C_ITR_ITBUFEN;
+      }
+      else
+      {
+        I2C_TransmitEnd();
+      }
+    }
+  }
+  else if (I2C_Receiving != FALSE)
+  {
+    I2C_ReceiveBytes(sr1);
+  }
+  else
+  {
+    I2C_TransmitBytes(sr1);
+  }
+}
+#endif /* I2C_TRANSFER_SUPPORT */
+
+#if defined (I2C_SLAVE_SUPPORT)
+/**
+  * @brief  Reports the registers written by the host since the last call
+  *         (end of a write, at STOP or repeated START).
+  * @param  None
+  * @retval None
+  */
+static void I2C_SlaveWriteEnd(void)
+{
+  if ((I2C_SlaveCount != 0) && (I2C_SlaveCallback != 0))
+  {
+    I2C_SlaveCallback(I2C_SlaveFirst, I2C_SlaveCount);
+  }
+  I2C_SlaveCount = 0;
+}
+
+/**
+  * @brief  Moves the register pointer to the next register, wrapping at the
+  *         end of the map.
+  * @param  None
+  * @retval None
+  */
+static void I2C_SlaveNext(void)
+{
+  I2C_SlavePointer++;
+  if (I2C_SlavePointer == I2C_SlaveSize)
+  {
+    I2C_SlavePointer = 0;
+  }
+}
+
+/**
+  * @brief  Runs the slave register map state machine. The first byte written
+  *         by the host sets the register pointer, the next ones are written
+  *         to the map through the write mask; reads return the map. The
+  *         pointer is incremented after each byte.
+  * @param  None
+  * @retval None
+  */
+static void I2C_SlaveEvent(void)
+{
+  uint8_t sr1 = 0, sr2 = 0, data = 0, mask = 0xFF;
+
+  sr1 = I2C->SR1;
+  sr2 = I2C->SR2;
+  if ((sr2 & (I2C_SR2_BERR | I2C_SR2_ARLO | I2C_SR2_AF | I2C_SR2_OVR)) != 0)
+  {
+    I2C->SR2 = 0;
+    /* EV3-2: the host ends its read with a NACK and no STOPF follows, the
+       access ends here as on EV4 */
+    if ((sr2 & (I2C_SR2_BERR | I2C_SR2_AF)) != 0)
+    {
+      I2C_SlaveWriteEnd();
+      I2C_SlaveActive = FALSE;
+    }
+    /* The byte already loaded in DR is not sent, so the pointer goes back
+       to it */
+    if (((sr2 & I2C_SR2_AF) != 0) && ((sr1 & I2C_SR1_TXE) == 0) &&
+        (I2C_SlavePointer < I2C_SlaveSize))
+    {
+      I2C_SlavePointer = (I2C_SlavePointer == 0) ? (uint8_t)(I2C_SlaveSize - 1) :
+                                                   (uint8_t)(I2C_SlavePointer - 1);
+    }
+  }
+
+  if ((sr1 & I2C_SR1_ADDR) != 0)
+  {
+    /* EV1: ADDR is cleared by reading SR3 after SR1 */
+    I2C_SlaveWriteEnd();
+    I2C_SlaveActive = TRUE;
+    I2C_SlaveRegisterByte = ((I2C->SR3 & I2C_SR3_TRA) == 0) ? TRUE : FALSE;
+  }
+
+  if (I2C_SlaveActive == FALSE)
+  {
+    /* Access ended by the NACK or the bus error above: the data flags read
+       before are stale, no byte is loaded or stored */
+  }
+  else if ((sr1 & I2C_SR1_RXNE) != 0)
+  {
+    /* EV2 */
+    data = I2C->DR;
+    if (I2C_SlaveRegisterByte != FALSE)
+    {
+      I2C_SlaveRegisterByte = FALSE;
+      I2C_SlavePointer = data;
+      I2C_SlaveFirst = data;
+    }
+    else if (I2C_SlavePointer < I2C_SlaveSize)
+    {
+      if (I2C_SlaveMask != 0)
+      {
+        mask = I2C_SlaveMask[I2C_SlavePointer];
+      }
+      I2C_SlaveMap[I2C_SlavePointer] = (uint8_t)((uint8_t)(I2C_SlaveMap[I2C_SlavePointer] & (uint8_t)(~mask)) |
+                                                 (uint8_t)(data & mask));
+      I2C_SlaveCount++;
+      I2C_SlaveNext();
+    }
+  }
+  else if ((sr1 & I2C_SR1_TXE) != 0)
+  {
+    /* EV3: the next byte is loaded at once so that the clock is not stretched */
+    if (I2C_SlavePointer < I2C_SlaveSize)
+    {
+      I2C->DR = I2C_SlaveMap[I2C_SlavePointer];
+      I2C_SlaveNext();
+    }
+    else
+    {
+      I2C->DR = 0xFF;
+    }
+  }
+
+  if ((sr1 & I2C_SR1_STOPF) != 0)
+  {
+    /* EV4: STOPF is cleared by writing CR2 after reading SR1 */
+    I2C->CR2 |= I2C_CR2_ACK;
+    I2C_SlaveWriteEnd();
+    I2C_SlaveActive = FALSE;
+  }
+}
+#endif /* I2C_SLAVE_SUPPORT */
 
 
 /**
@@ -892,6 +1393,376 @@ void I2C_ClearITPendingBit(I2C_ITPendingBit_TypeDef I2C_ITPendingBit)
   I2C->SR2 = (uint8_t)((uint16_t)~flagpos);
 }
 
+#if defined (I2C_TIMEOUT_SUPPORT)
+/**
+  * @brief  Configures the timeout of I2C_WaitEvent(), I2C_WaitFlagStatus()
+  *         and of the transfer start.
+  * @param  GetTick : function returning a free running 16-bit tick counter
+  *         (a timer or a millisecond tick for instance), or 0 to count the
+  *         polling loops of the waits.
+  * @param  Timeout : timeout in ticks of GetTick.
+  * @retval None
+  */
+void I2C_TimeoutConfig(I2C_GetTick_TypeDef GetTick, uint16_t Timeout)
+{
+  I2C_GetTick = GetTick;
+  I2C_Timeout = Timeout;
+}
+
+/**
+  * @brief  Waits for an I2C event with a timeout, see I2C_CheckEvent().
+  * @param  I2C_Event : event to wait for.
+  *         This parameter can be any of the @ref I2C_Event_TypeDef enumeration.
+  * @retval ErrorStatus : SUCCESS when the event occurred, ERROR on timeout
+  *         (the bus may then be released with I2C_BusRecovery()).
+  */
+ErrorStatus I2C_WaitEvent(I2C_Event_TypeDef I2C_Event)
+{
+  uint16_t start = I2C_GetTickNow();
+
+  while (I2C_CheckEvent(I2C_Event) == ERROR)
+  {
+    if (I2C_TimeoutElapsed(start) != FALSE)
+    {
+      return ERROR;
+    }
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  Waits for an I2C flag to reach a given status with a timeout.
+  * @param  I2C_Flag : flag to wait for.
+  *         This parameter can be any of the @ref I2C_Flag_TypeDef enumeration.
+  * @param  Status : status to wait for (SET or RESET).
+  * @retval ErrorStatus : SUCCESS when the flag has the status, ERROR on timeout.
+  */
+ErrorStatus I2C_WaitFlagStatus(I2C_Flag_TypeDef I2C_Flag, FlagStatus Status)
+{
+  uint16_t start = I2C_GetTickNow();
+
+  while (I2C_GetFlagStatus(I2C_Flag) != Status)
+  {
+    if (I2C_TimeoutElapsed(start) != FALSE)
+    {
+      return ERROR;
+    }
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  Releases a stuck bus and restarts the I2C: the peripheral is
+  *         disabled, SCL is pulsed by GPIO (9 pulses at most) until the slave
+  *         holding SDA low releases it, a STOP condition is generated, then
+  *         the I2C is reset by I2C_SoftwareResetCmd() and its configuration
+  *         restored.
+  * @param  None
+  * @note   A master transfer in progress ends with the I2C_TRANSFER_ERROR
+  *         status. Takes about 100 us at 100 kHz.
+  * @retval ErrorStatus : SUCCESS if SCL and SDA are both released.
+  */
+ErrorStatus I2C_BusRecovery(void)
+{
+  uint8_t cr1 = 0, freqr = 0, oarl = 0, oarh = 0, ccrl = 0, ccrh = 0, triser = 0, itr = 0;
+  uint8_t loops = 0, pulses = 0;
+  ErrorStatus status = ERROR;
+#if defined (I2C_TRANSFER_SUPPORT)
+  I2C_Transfer_TypeDef* transfer = I2C_Transfer;
+#endif /* I2C_TRANSFER_SUPPORT */
+
+  /* Save the configuration and release the pins to the GPIO */
+  cr1 = I2C->CR1;
+  freqr = I2C->FREQR;
+  oarl = I2C->OARL;
+  oarh = I2C->OARH;
+  ccrl = I2C->CCRL;
+  ccrh = I2C->CCRH;
+  triser = I2C->TRISER;
+  itr = I2C->ITR;
+  I2C->ITR = 0;
+  I2C->CR1 &= (uint8_t)(~I2C_CR1_PE);
+
+  /* Quarter of a 100 kHz period, about 4 cycles per loop */
+  loops = (uint8_t)((CLK_GetCPUClockFreq() / 1600000) + 1);
+
+  GPIO_Init(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN, GPIO_MODE_OUT_OD_HIZ_FAST);
+  GPIO_Init(I2C_SDA_GPIO_PORT, I2C_SDA_GPIO_PIN, GPIO_MODE_OUT_OD_HIZ_FAST);
+
+  /* Clock the slave through the rest of its byte until it releases SDA */
+  while ((GPIO_ReadInputPin(I2C_SDA_GPIO_PORT, I2C_SDA_GPIO_PIN) == RESET) && (pulses < 9))
+  {
+    GPIO_WriteLow(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN);
+    I2C_RecoveryDelay((uint8_t)(loops << 1));
+    GPIO_WriteHigh(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN);
+    I2C_RecoveryDelay((uint8_t)(loops << 1));
+    pulses++;
+  }
+
+  /* STOP condition: SDA rises while SCL is high */
+  GPIO_WriteLow(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN);
+  I2C_RecoveryDelay(loops);
+  GPIO_WriteLow(I2C_SDA_GPIO_PORT, I2C_SDA_GPIO_PIN);
+  I2C_RecoveryDelay(loops);
+  GPIO_WriteHigh(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN);
+  I2C_RecoveryDelay(loops);
+  GPIO_WriteHigh(I2C_SDA_GPIO_PORT, I2C_SDA_GPIO_PIN);
+  I2C_RecoveryDelay(loops);
+
+  if ((GPIO_ReadInputPin(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN) != RESET) &&
+      (GPIO_ReadInputPin(I2C_SDA_GPIO_PORT, I2C_SDA_GPIO_PIN) != RESET))
+  {
+    status = SUCCESS;
+  }
+
+  GPIO_Init(I2C_SCL_GPIO_PORT, I2C_SCL_GPIO_PIN, GPIO_MODE_IN_FL_NO_IT);
+  GPIO_Init(I2C_SDA_GPIO_PORT, I2C_SDA_GPIO_PIN, GPIO_MODE_IN_FL_NO_IT);
+
+  /* Reset the I2C state machine and restore the configuration */
+  I2C_SoftwareResetCmd(ENABLE);
+  I2C_SoftwareResetCmd(DISABLE);
+  I2C->FREQR = freqr;
+  I2C->OARL = oarl;
+  I2C->OARH = oarh;
+  I2C->CCRL = ccrl;
+  I2C->CCRH = ccrh;
+  I2C->TRISER = triser;
+  I2C->CR1 = cr1;
+  I2C->ITR = itr;
+
+#if defined (I2C_SLAVE_SUPPORT)
+  I2C_SlaveActive = FALSE;
+  if (I2C_SlaveEnabled != FALSE)
+  {
+    I2C_SlaveCmd(ENABLE);
+  }
+#endif /* I2C_SLAVE_SUPPORT */
+#if defined (I2C_TRANSFER_SUPPORT)
+  if (transfer != 0)
+  {
+    I2C_TransferEnd(I2C_TRANSFER_ERROR);
+  }
+#endif /* I2C_TRANSFER_SUPPORT */
+
+  return status;
+}
+#endif /* I2C_TIMEOUT_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT)
+/**
+  * @brief  Starts an interrupt driven master transfer: write TxLength bytes,
+  *         then read RxLength bytes after a repeated START, then STOP.
+  *         The 1-, 2- and N-byte receive sequences of the reference manual
+  *         are run by I2C_ISR(), which must be called from the I2C interrupt.
+  * @param  Transfer : transfer descriptor, Status is set to I2C_TRANSFER_BUSY
+  *         then to the final status before Callback is called.
+  * @note   The I2C must be initialized and enabled, and the interrupts enabled.
+  *         The transfer queue is bypassed, see I2C_QueueTransfer().
+  *         The transfer is not started if the STOP condition of the
+  *         previous transfer is not sent within two SCL periods (bus
+  *         stuck), so that a transfer chained from the I2C interrupt never
+  *         blocks it: Status is then I2C_TRANSFER_ERROR, and Callback is
+  *         not called.
+  * @retval ErrorStatus : ERROR if a transfer is already in progress or if
+  *         the bus is stuck.
+  */
+ErrorStatus I2C_MasterTransfer(I2C_Transfer_TypeDef* Transfer)
+{
+  /* Check the parameters */
+  assert_param(IS_I2C_TRANSFER_ADDRESS_OK(Transfer->Address));
+
+  if (I2C_Transfer != 0)
+  {
+    return ERROR;
+  }
+
+  Transfer->Status = I2C_TRANSFER_BUSY;
+  I2C_Transfer = Transfer;
+
+  /* Wait for the STOP condition of the previous transfer to be sent */
+  if (I2C_WaitStopSent() == FALSE)
+  {
+    /* The bus is stuck: the transfer fails without being started */
+    I2C_Transfer = 0;
+    Transfer->Status = I2C_TRANSFER_ERROR;
+    return ERROR;
+  }
+
+  I2C->CR2 &= (uint8_t)(~I2C_CR2_POS);
+  I2C->ITR |= (uint8_t)(I2C_ITR_ITEVTEN | I2C_ITR_ITERREN);
+
+  if ((Transfer->TxLength == 0) && (Transfer->RxLength != 0))
+  {
+    I2C_StartReceive();
+  }
+  else
+  {
+    I2C_Receiving = FALSE;
+    I2C_Count = Transfer->TxLength;
+    I2C_Index = 0;
+    I2C->CR2 |= I2C_CR2_START;
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  Queues a master transfer. It is started at once if the bus is
+  *         idle, else by the I2C interrupt right after the end of the
+  *         transfers queued before it, without returning to the main loop.
+  * @param  Transfer : transfer descriptor, see I2C_MasterTransfer(). Status is
+  *         I2C_TRANSFER_QUEUED until the transfer is started.
+  * @note   May be called from the main loop or from any interrupt, including
+  *         a transfer callback, or in a critical section; the interrupts are
+  *         masked while the queue is updated, then the level of the caller
+  *         is restored. Transfers left queued after a stuck bus are started
+  *         by the next call.
+  * @retval ErrorStatus : ERROR if the queue is full, or if the transfer
+  *         could not be started at once because the bus is stuck (Status is
+  *         then I2C_TRANSFER_ERROR).
+  */
+ErrorStatus I2C_QueueTransfer(I2C_Transfer_TypeDef* Transfer)
+{
+  ErrorStatus status = SUCCESS;
+  uint8_t cc = 0;
+
+  /* Check the parameters */
+  assert_param(IS_I2C_TRANSFER_ADDRESS_OK(Transfer->Address));
+
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+
+  if ((I2C_Transfer == 0) && (I2C_QueueHead == I2C_QueueTail))
+  {
+    status = I2C_MasterTransfer(Transfer);
+  }
+  else if ((uint8_t)(I2C_QueueHead - I2C_QueueTail) < (uint8_t)I2C_TRANSFER_QUEUE_SIZE)
+  {
+    Transfer->Status = I2C_TRANSFER_QUEUED;
+    I2C_Queue[I2C_QueueHead & (uint8_t)(I2C_TRANSFER_QUEUE_SIZE - 1)] = Transfer;
+    I2C_QueueHead++;
+    /* Engine free with transfers left queued by a stuck bus */
+    if ((I2C_Transfer == 0) && (I2C_QueueRunning == FALSE))
+    {
+      I2C_QueueNext();
+    }
+  }
+  else
+  {
+    status = ERROR;
+  }
+
+  ITC_RestoreLevel(cc);
+
+  return status;
+}
+
+/**
+  * @brief  Checks whether a master transfer is in progress or queued.
+  * @param  None
+  * @retval FlagStatus : SET while a transfer is in progress or queued.
+  */
+FlagStatus I2C_GetTransferBusy(void)
+{
+  return (((I2C_Transfer != 0) || (I2C_QueueHead != I2C_QueueTail)) ? SET : RESET);
+}
+#endif /* I2C_TRANSFER_SUPPORT */
+
+#if defined (I2C_SLAVE_SUPPORT)
+/**
+  * @brief  Configures the register map exposed in slave mode at the own
+  *         address set by I2C_Init().
+  * @param  Map : registers read and written by the host.
+  * @param  WriteMask : writable bits of each register (Size bytes), or 0 if
+  *         all the bits of all the registers are writable.
+  * @param  Size : number of registers, 1 to 255. Registers above the map
+  *         read as 0xFF and ignore writes.
+  * @param  Callback : called from the I2C interrupt at the end of each host
+  *         write with the first register and the number of registers
+  *         written, may be 0.
+  * @note   The slave is then enabled with I2C_SlaveCmd().
+  * @retval None
+  */
+void I2C_SlaveRegisterMapConfig(uint8_t* Map, const uint8_t* WriteMask,
+                                uint8_t Size, I2C_SlaveCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_I2C_SLAVE_MAP_SIZE_OK(Size));
+
+  I2C_SlaveCmd(DISABLE);
+  I2C_SlaveMap = Map;
+  I2C_SlaveMask = WriteMask;
+  I2C_SlaveSize = Size;
+  I2C_SlaveCallback = Callback;
+  I2C_SlavePointer = 0;
+  I2C_SlaveCount = 0;
+}
+
+/**
+  * @brief  Enables or disables the slave register map emulation.
+  * @param  NewState : new state of the slave mode.
+  *         This parameter can be any of the @ref FunctionalState enumeration.
+  * @note   When enabled, the own address is acknowledged and the I2C
+  *         interrupts are enabled; I2C_ISR() must be called from the I2C
+  *         interrupt routine. Master transfers may still be started, the
+  *         slave mode is resumed at their end.
+  * @retval None
+  */
+void I2C_SlaveCmd(FunctionalState NewState)
+{
+  /* Check the parameters */
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+
+  if (NewState != DISABLE)
+  {
+    I2C_SlaveEnabled = TRUE;
+    I2C->CR2 |= I2C_CR2_ACK;
+    I2C->ITR |= (uint8_t)(I2C_ITR_ITBUFEN | I2C_ITR_ITEVTEN | I2C_ITR_ITERREN);
+  }
+  else
+  {
+    I2C_SlaveEnabled = FALSE;
+    I2C_SlaveActive = FALSE;
+    I2C->CR2 &= (uint8_t)(~I2C_CR2_ACK);
+    I2C->ITR &= (uint8_t)(~(I2C_ITR_ITBUFEN | I2C_ITR_ITEVTEN | I2C_ITR_ITERREN));
+  }
+}
+#endif /* I2C_SLAVE_SUPPORT */
+
+#if defined (I2C_TRANSFER_SUPPORT) || defined (I2C_SLAVE_SUPPORT)
+/**
+  * @brief  Runs the master transfer and slave register map state machines,
+  *         to be called from the I2C interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void I2C_ISR(void)
+{
+#if defined (I2C_TRANSFER_SUPPORT)
+  if (I2C_Transfer != 0)
+  {
+#if defined (I2C_SLAVE_SUPPORT)
+    /* A START waiting for the bus to be free may be overtaken by the host
+       accessing the own address: the events are the master ones only in
+       master mode or when the arbitration has just been lost */
+    if ((I2C_SlaveActive == FALSE) &&
+        (((I2C->SR3 & I2C_SR3_MSL) != 0) || ((I2C->SR2 & I2C_SR2_ARLO) != 0)))
+#endif /* I2C_SLAVE_SUPPORT */
+    {
+      I2C_MasterEvent();
+      return;
+    }
+  }
+#endif /* I2C_TRANSFER_SUPPORT */
+
+#if defined (I2C_SLAVE_SUPPORT)
+  I2C_SlaveEvent();
+#else
+  /* No transfer in progress: clear the error flags */
+  I2C->SR2 = 0;
+#endif /* I2C_SLAVE_SUPPORT */
+}
+#endif /* I2C_TRANSFER_SUPPORT || I2C_SLAVE_SUPPORT */
+
 /**
   * @}
   */
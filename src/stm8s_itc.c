@@ -71,6 +71,75 @@ uint8_t ITC_GetCPUCC(void)
 #pragma restore
 #endif // _SDCC_
 
+/**
+  * @brief  Utility function used to write CC register.
+  * @param  CC: new CPU CC register value.
+  * @retval None
+  */
+#ifdef _SDCC_
+#pragma save
+#pragma disable_warning 85
+#endif // _SDCC_
+void ITC_SetCPUCC(uint8_t CC)
+{
+#ifdef _COSMIC_
+  _asm("push a"); /* CC is passed in the A register */
+  _asm("pop cc");
+#elif defined _RAISONANCE_ /* _RAISONANCE_ */
+  _setCC_(CC);
+#elif defined _SDCC_ /* _SDCC_ */
+#if defined (__SDCCCALL) && (__SDCCCALL == 1)
+  __asm__("push a"); /* CC is passed in the A register */
+#elif defined (__SDCC_MODEL_LARGE)
+  __asm__("ld a, (4, sp)"); /* CC is passed on the stack, above the 24-bit return address */
+  __asm__("push a");
+#else
+  __asm__("ld a, (3, sp)"); /* CC is passed on the stack, above the return address */
+  __asm__("push a");
+#endif /* __SDCCCALL */
+  __asm__("pop cc");
+#else /* _IAR_ */
+  asm("push a"); /* CC is passed in the A register */
+  asm("pop cc");
+#endif /* _COSMIC_*/
+}
+#ifdef _SDCC_
+#pragma restore
+#endif // _SDCC_
+
+#if defined (ITC_PLAN_SUPPORT)
+/**
+  * @brief  Counts the distinct budgets of a plan below a given budget.
+  * @param  Plan: interrupt sources of the plan.
+  * @param  Count: number of sources.
+  * @param  Budget: budget compared.
+  * @retval Rank of Budget among the distinct budgets, 0 for the tightest
+  */
+static uint8_t ITC_CountBudgetsBelow(const ITC_Plan_TypeDef* Plan, uint8_t Count, uint16_t Budget)
+{
+  uint8_t rank = 0;
+  uint8_t i = 0;
+  uint8_t j = 0;
+
+  for (i = 0; i < Count; i++)
+  {
+    if (Plan[i].Budget < Budget)
+    {
+      /* Count each budget value once, at its first occurrence */
+      for (j = 0; (j < i) && (Plan[j].Budget != Plan[i].Budget); j++)
+      {
+      }
+      if (j == i)
+      {
+        rank++;
+      }
+    }
+  }
+
+  return rank;
+}
+#endif /* ITC_PLAN_SUPPORT */
+
 
 /**
   * @}
@@ -341,6 +410,125 @@ void ITC_SetSoftwarePriority(ITC_Irq_TypeDef IrqNum, ITC_PriorityLevel_TypeDef P
   }
 }
 
+#if defined (ITC_PLAN_SUPPORT)
+/**
+  * @brief  Sets the software priorities of all the interrupt sources at once
+  *         from a plan, usually a const table: the tighter the latency
+  *         budget, the higher the level, so a source preempts the sources
+  *         with looser budgets. The distinct budgets are spread over the
+  *         levels 3 (tightest) to 1; the sources absent from the plan get
+  *         the level 1.
+  * @note   The 7 priority registers are built in RAM and written once each,
+  *         instead of a read-modify-write per source.
+  * @param  Plan: interrupt sources of the plan.
+  * @param  Count: number of sources, up to 25.
+  * @par Required preconditions:
+  *         Interrupts disabled (as after reset), see ITC_SetSoftwarePriority().
+  * @retval None
+  */
+void ITC_ApplyPlan(const ITC_Plan_TypeDef* Plan, uint8_t Count)
+{
+  /* Level 1 (01b) in every field */
+  uint8_t image[7] = {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55};
+  uint8_t distinct = 0;
+  uint8_t rank = 0;
+  uint8_t level = 0;
+  uint8_t shift = 0;
+  uint8_t i = 0;
+
+  /* Check function parameters */
+  assert_param(IS_ITC_PLAN_COUNT_OK(Count));
+  assert_param(IS_ITC_INTERRUPTS_DISABLED);
+
+  /* Number of distinct budgets: rank of a budget above all */
+  distinct = ITC_CountBudgetsBelow(Plan, Count, 0xFFFF);
+  for (i = 0; i < Count; i++)
+  {
+    if (Plan[i].Budget == 0xFFFF)
+    {
+      distinct++;
+      break;
+    }
+  }
+
+  for (i = 0; i < Count; i++)
+  {
+    assert_param(IS_ITC_IRQ_OK((uint8_t)Plan[i].Irq));
+
+    rank = ITC_CountBudgetsBelow(Plan, Count, Plan[i].Budget);
+    /* Level number 3 to 1, then its register encoding */
+    level = (uint8_t)(3 - (uint8_t)((uint8_t)(rank * 3) / distinct));
+    if (level == 3)
+    {
+      level = (uint8_t)ITC_PRIORITYLEVEL_3;
+    }
+    else if (level == 2)
+    {
+      level = (uint8_t)ITC_PRIORITYLEVEL_2;
+    }
+    else
+    {
+      level = (uint8_t)ITC_PRIORITYLEVEL_1;
+    }
+
+    shift = (uint8_t)(((uint8_t)Plan[i].Irq % 4U) * 2U);
+    image[(uint8_t)Plan[i].Irq / 4U] &= (uint8_t)(~(uint8_t)(0x03U << shift));
+    image[(uint8_t)Plan[i].Irq / 4U] |= (uint8_t)(level << shift);
+  }
+
+  ITC->ISPR1 = image[0];
+  ITC->ISPR2 = image[1];
+  ITC->ISPR3 = image[2];
+  ITC->ISPR4 = image[3];
+  ITC->ISPR5 = image[4];
+  ITC->ISPR6 = image[5];
+  ITC->ISPR7 = image[6];
+}
+#endif /* ITC_PLAN_SUPPORT */
+
+/**
+  * @brief  Raises the CPU level to mask the interrupts of a level up to
+  *         Level, for a critical section shared with them; the more urgent
+  *         interrupts still preempt. The level is never lowered, so the
+  *         call nests in interrupt routines and in other critical sections.
+  * @param  Level: ITC_PRIORITYLEVEL_1 to ITC_PRIORITYLEVEL_3 (all maskable
+  *         interrupts masked).
+  * @retval CPU CC register value to pass to ITC_RestoreLevel()
+  */
+uint8_t ITC_RaiseLevel(ITC_PriorityLevel_TypeDef Level)
+{
+  /* Order of the levels, indexed by their encoding */
+  static const uint8_t rank[4] = {2, 1, 0, 3};
+  uint8_t cc = 0;
+  uint8_t current = 0;
+
+  /* Check function parameters */
+  assert_param(IS_ITC_RAISE_LEVEL_OK(Level));
+
+  cc = ITC_GetCPUCC();
+  /* I1 is bit 5 and I0 bit 3 of CC */
+  current = (uint8_t)(((cc >> 4) & 0x02) | ((cc >> 3) & 0x01));
+  if (rank[(uint8_t)Level] > rank[current])
+  {
+    ITC_SetCPUCC((uint8_t)((uint8_t)(cc & (uint8_t)(~CPU_CC_I1I0)) |
+                           (uint8_t)(((uint8_t)Level & 0x02) << 4) |
+                           (uint8_t)(((uint8_t)Level & 0x01) << 3)));
+  }
+
+  return cc;
+}
+
+/**
+  * @brief  Restores the CPU level saved by ITC_RaiseLevel().
+  * @param  SavedCC: value returned by ITC_RaiseLevel().
+  * @retval None
+  */
+void ITC_RestoreLevel(uint8_t SavedCC)
+{
+  ITC_SetCPUCC((uint8_t)((uint8_t)(ITC_GetCPUCC() & (uint8_t)(~CPU_CC_I1I0)) |
+                         (uint8_t)(SavedCC & CPU_CC_I1I0)));
+}
+
 /**
   * @}
   */
@@ -0,0 +1,207 @@
+/**
+  ******************************************************************************
+  * @file    stm8s_sched.c
+  * @author  MCD Application Team
+  * @version V2.2.0
+  * @date    30-September-2014
+  * @brief   This file contains the cooperative run to completion event
+  *          scheduler: interrupt routines post events to per priority
+  *          queues, the main loop runs their handlers.
+   ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm8s_sched.h"
+
+/** @addtogroup STM8S_StdPeriph_Driver
+  * @{
+  */
+
+#if defined (SCHED_SUPPORT)
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  SCHED_Handler_TypeDef Handler;
+  uint8_t Param;
+} SCHED_Event_TypeDef;
+
+typedef struct
+{
+  SCHED_Event_TypeDef Events[SCHED_QUEUE_SIZE];
+  uint8_t Head; /* Free running, written by SCHED_Post() */
+  uint8_t Tail; /* Free running, written by SCHED_Dispatch() */
+} SCHED_Queue_TypeDef;
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#if !IS_SCHED_PRIORITIES_OK(SCHED_PRIORITIES)
+ #error "SCHED_PRIORITIES must be between 1 and 8"
+#endif
+#if !IS_SCHED_QUEUE_SIZE_OK(SCHED_QUEUE_SIZE)
+ #error "SCHED_QUEUE_SIZE must be a power of two from 2 to 128"
+#endif
+/* Private variables ---------------------------------------------------------*/
+static SCHED_Queue_TypeDef SCHED_Queues[SCHED_PRIORITIES];
+static volatile uint8_t SCHED_Ready = 0; /* Non empty queues, bit 0 for priority 0 */
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+/* Public functions ----------------------------------------------------------*/
+
+/**
+  * @addtogroup SCHED_Public_Functions
+  * @{
+  */
+
+/**
+  * @brief  Empties all the event queues.
+  * @param  None
+  * @retval None
+  */
+void SCHED_Init(void)
+{
+  uint8_t priority = 0;
+  uint8_t cc = 0;
+
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  for (priority = 0; priority < SCHED_PRIORITIES; priority++)
+  {
+    SCHED_Queues[priority].Head = 0;
+    SCHED_Queues[priority].Tail = 0;
+  }
+  SCHED_Ready = 0;
+  ITC_RestoreLevel(cc);
+}
+
+/**
+  * @brief  Posts an event, from an interrupt routine or from the main loop.
+  * @param   Priority: queue of the event, 0 (most urgent) to
+  *         SCHED_PRIORITIES - 1.
+  * @param   Handler: function run by the dispatcher.
+  * @param   Param: value passed to Handler.
+  * @note   The interrupts are masked for the few instructions queuing the
+  *         event, then the level of the caller is restored.
+  * @retval ERROR if the queue is full, SUCCESS otherwise
+  */
+ErrorStatus SCHED_Post(uint8_t Priority, SCHED_Handler_TypeDef Handler, uint8_t Param)
+{
+  SCHED_Queue_TypeDef* queue = &SCHED_Queues[Priority];
+  SCHED_Event_TypeDef* event = 0;
+  ErrorStatus status = ERROR;
+  uint8_t cc = 0;
+
+  /* Check the parameters */
+  assert_param(IS_SCHED_PRIORITY_OK(Priority));
+
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  if ((uint8_t)(queue->Head - queue->Tail) < (uint8_t)SCHED_QUEUE_SIZE)
+  {
+    event = &queue->Events[queue->Head & (uint8_t)(SCHED_QUEUE_SIZE - 1)];
+    event->Handler = Handler;
+    event->Param = Param;
+    queue->Head++;
+    SCHED_Ready |= (uint8_t)(1 << Priority);
+    status = SUCCESS;
+  }
+  ITC_RestoreLevel(cc);
+
+  return status;
+}
+
+/**
+  * @brief  Runs the oldest event of the most urgent non empty queue.
+  * @param  None
+  * @par Required preconditions:
+  *         Called from the main loop, with interrupts enabled.
+  * @retval TRUE if an event was run, FALSE if all the queues are empty
+  */
+bool SCHED_Dispatch(void)
+{
+  SCHED_Queue_TypeDef* queue = 0;
+  SCHED_Handler_TypeDef handler = 0;
+  uint8_t param = 0;
+  uint8_t priority = 0;
+  uint8_t ready = SCHED_Ready;
+  uint8_t cc = 0;
+
+  if (ready == 0)
+  {
+    return FALSE;
+  }
+  while ((ready & 0x01) == 0)
+  {
+    ready >>= 1;
+    priority++;
+  }
+
+  queue = &SCHED_Queues[priority];
+  handler = queue->Events[queue->Tail & (uint8_t)(SCHED_QUEUE_SIZE - 1)].Handler;
+  param = queue->Events[queue->Tail & (uint8_t)(SCHED_QUEUE_SIZE - 1)].Param;
+
+  cc = ITC_RaiseLevel(ITC_PRIORITYLEVEL_3);
+  queue->Tail++;
+  if (queue->Tail == queue->Head)
+  {
+    SCHED_Ready &= (uint8_t)(~(uint8_t)(1 << priority));
+  }
+  ITC_RestoreLevel(cc);
+
+  /* Run to completion, at the level of the caller */
+  handler(param);
+
+  return TRUE;
+}
+
+/**
+  * @brief  Runs the events forever, sleeping in WFI mode whenever all the
+  *         queues are empty.
+  * @param  None
+  * @par Required preconditions:
+  *         Called from the main loop once initialized. The queues are
+  *         checked with the interrupts masked and WFI enables them again
+  *         atomically, so an event posted just before cannot be slept over.
+  * @retval None
+  */
+void SCHED_Run(void)
+{
+  while (1)
+  {
+    disableInterrupts();
+    if (SCHED_Ready == 0)
+    {
+      wfi();
+    }
+    else
+    {
+      enableInterrupts();
+      (void)SCHED_Dispatch();
+    }
+  }
+}
+
+/**
+  * @}
+  */
+#endif /* SCHED_SUPPORT */
+
+/**
+  * @}
+  */
+
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
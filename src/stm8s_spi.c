@@ -35,8 +35,60 @@
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined (SPI_TRANSFER_SUPPORT)
+static const uint8_t* SPI_TxPointer = 0;  /* Next byte to send, 0 for dummy bytes */
+static uint8_t* SPI_RxPointer = 0;        /* Next byte to receive, 0 to discard */
+static uint16_t SPI_TxCount = 0;          /* Bytes left to write to DR */
+static volatile uint16_t SPI_RxCount = 0; /* Bytes left to read from DR */
+static SPI_TransferCallback_TypeDef SPI_Callback = 0;
+#endif /* SPI_TRANSFER_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
+#if defined (SPI_TRANSFER_SUPPORT)
+/**
+  * @brief  Writes the next byte of the interrupt driven transfer to DR.
+  * @param  None
+  * @retval None
+  */
+static void SPI_WriteNext(void)
+{
+  if (SPI_TxPointer != 0)
+  {
+    SPI->DR = *SPI_TxPointer++;
+  }
+  else
+  {
+    SPI->DR = SPI_DUMMY_BYTE;
+  }
+  SPI_TxCount--;
+}
+
+/**
+  * @brief  Enables (and resets) or disables the hardware CRC calculation;
+  *         CRCEN is only written while the SPI is disabled.
+  * @param  NewState : new state of the CRC calculation.
+  * @retval None
+  */
+static void SPI_FrameCRCCmd(FunctionalState NewState)
+{
+  uint8_t cr1 = SPI->CR1;
+
+  while ((SPI->SR & SPI_SR_BSY) != 0)
+  {}
+  SPI->CR1 = (uint8_t)(cr1 & (uint8_t)(~SPI_CR1_SPE));
+  if (NewState != DISABLE)
+  {
+    /* Writing CRCEN to 1 resets the CRC registers */
+    SPI->CR2 |= SPI_CR2_CRCEN;
+    SPI->SR = (uint8_t)(~SPI_SR_CRCERR);
+  }
+  else
+  {
+    SPI->CR2 &= (uint8_t)(~SPI_CR2_CRCEN);
+  }
+  SPI->CR1 = cr1;
+}
+#endif /* SPI_TRANSFER_SUPPORT */
 
 /** @addtogroup SPI_Public_Functions
   * @{
@@ -423,6 +475,279 @@ void SPI_ClearITPendingBit(SPI_IT_TypeDef SPI_IT)
   
 }
 
+#if defined (SPI_TRANSFER_SUPPORT)
+/**
+  * @brief  Transfers a block in full duplex, polling the flags. The next byte
+  *         is written as soon as TXE is set so that the shift register is
+  *         always fed; without receive buffer the received bytes are not read
+  *         at all, which keeps the bytes back to back at fMASTER/2.
+  * @param  TxBuffer : bytes to send, or 0 to send SPI_DUMMY_BYTE.
+  * @param  RxBuffer : received bytes, or 0 to discard them.
+  * @param  Length : number of bytes to transfer.
+  * @note   The SPI must be enabled in master mode. Returns when the last
+  *         byte has been shifted out (BSY reset).
+  * @retval None
+  */
+void SPI_TransferBlock(const uint8_t* TxBuffer, uint8_t* RxBuffer, uint16_t Length)
+{
+  uint8_t data = SPI_DUMMY_BYTE;
+
+  if (Length == 0)
+  {
+    return;
+  }
+
+  if (RxBuffer == 0)
+  {
+    /* Transmit only: the overrun flag raised meanwhile is cleared at the end */
+    while (Length != 0)
+    {
+      if (TxBuffer != 0)
+      {
+        data = *TxBuffer++;
+      }
+      while ((SPI->SR & SPI_SR_TXE) == 0)
+      {}
+      SPI->DR = data;
+      Length--;
+    }
+    while ((SPI->SR & SPI_SR_TXE) == 0)
+    {}
+    while ((SPI->SR & SPI_SR_BSY) != 0)
+    {}
+    (void)SPI->DR;
+    (void)SPI->SR;
+    return;
+  }
+
+  /* Full duplex: one byte in the shift register, the next one in DR */
+  if (TxBuffer != 0)
+  {
+    data = *TxBuffer++;
+  }
+  SPI->DR = data;
+  while (--Length != 0)
+  {
+    if (TxBuffer != 0)
+    {
+      data = *TxBuffer++;
+    }
+    while ((SPI->SR & SPI_SR_TXE) == 0)
+    {}
+    SPI->DR = data;
+    while ((SPI->SR & SPI_SR_RXNE) == 0)
+    {}
+    *RxBuffer++ = SPI->DR;
+  }
+  while ((SPI->SR & SPI_SR_RXNE) == 0)
+  {}
+  *RxBuffer = SPI->DR;
+  while ((SPI->SR & SPI_SR_BSY) != 0)
+  {}
+}
+
+/**
+  * @brief  Starts an interrupt driven full duplex block transfer. Two bytes
+  *         are written at once (shift register and DR), then each RXNE
+  *         interrupt reads one byte and writes the next one, so the bytes
+  *         stay back to back as long as the interrupt latency is shorter
+  *         than a byte time. SPI_ISR() must be called from the SPI interrupt.
+  * @param  TxBuffer : bytes to send, or 0 to send SPI_DUMMY_BYTE.
+  * @param  RxBuffer : received bytes, or 0 to discard them.
+  * @param  Length : number of bytes to transfer, 1 to 65535.
+  * @param  Callback : called from the SPI interrupt when the last byte has
+  *         been received (SUCCESS) or when a byte has been lost (ERROR),
+  *         may be 0.
+  * @note   The SPI must be enabled in master mode, and the interrupts enabled.
+  *         A byte lasts 16 fMASTER cycles with SPI_BAUDRATEPRESCALER_2, less
+  *         than the interrupt latency: the overrun (OVR) then ends the
+  *         transfer with the ERROR status, low prescalers are better served
+  *         by SPI_TransferBlock().
+  * @retval ErrorStatus : ERROR if a transfer is already in progress.
+  */
+ErrorStatus SPI_TransferBlockIT(const uint8_t* TxBuffer, uint8_t* RxBuffer, uint16_t Length,
+                                SPI_TransferCallback_TypeDef Callback)
+{
+  /* Check the parameters */
+  assert_param(IS_SPI_TRANSFER_LENGTH_OK(Length));
+
+  if (SPI_RxCount != 0)
+  {
+    return ERROR;
+  }
+
+  SPI_TxPointer = TxBuffer;
+  SPI_RxPointer = RxBuffer;
+  SPI_TxCount = Length;
+  SPI_Callback = Callback;
+
+  /* Flush a byte left in DR so that the first RXNE is the first byte */
+  (void)SPI->DR;
+  (void)SPI->SR;
+
+  SPI_RxCount = Length;
+  SPI_WriteNext();
+  if (SPI_TxCount != 0)
+  {
+    while ((SPI->SR & SPI_SR_TXE) == 0)
+    {}
+    SPI_WriteNext();
+  }
+  SPI->ICR |= (uint8_t)(SPI_ICR_RXEI | SPI_ICR_ERRIE);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  Checks whether an interrupt driven block transfer is in progress.
+  * @param  None
+  * @retval FlagStatus : SET while a transfer is in progress.
+  */
+FlagStatus SPI_GetTransferBusy(void)
+{
+  return ((SPI_RxCount != 0) ? SET : RESET);
+}
+
+/**
+  * @brief  Runs the interrupt driven block transfer, to be called from the
+  *         SPI interrupt routine.
+  * @param  None
+  * @retval None
+  */
+void SPI_ISR(void)
+{
+  uint8_t data = 0, sr = 0;
+
+  sr = SPI->SR;
+  if (SPI_RxCount == 0)
+  {
+    return;
+  }
+
+  if ((sr & SPI_SR_OVR) != 0)
+  {
+    /* A byte was lost: OVR is cleared by reading DR after SR, the bytes
+       still in flight are dropped */
+    (void)SPI->DR;
+    (void)SPI->SR;
+    SPI->ICR &= (uint8_t)(~(SPI_ICR_RXEI | SPI_ICR_ERRIE));
+    SPI_TxCount = 0;
+    SPI_RxCount = 0;
+    if (SPI_Callback != 0)
+    {
+      SPI_Callback(ERROR);
+    }
+    return;
+  }
+
+  if ((sr & SPI_SR_RXNE) == 0)
+  {
+    return;
+  }
+
+  data = SPI->DR;
+  if (SPI_TxCount != 0)
+  {
+    SPI_WriteNext();
+  }
+  if (SPI_RxPointer != 0)
+  {
+    *SPI_RxPointer++ = data;
+  }
+
+  if (--SPI_RxCount == 0)
+  {
+    SPI->ICR &= (uint8_t)(~(SPI_ICR_RXEI | SPI_ICR_ERRIE));
+    if (SPI_Callback != 0)
+    {
+      SPI_Callback(SUCCESS);
+    }
+  }
+}
+
+/**
+  * @brief  Transfers a block in full duplex framed by the hardware CRC: the
+  *         CRC of the sent bytes is appended by the SPI (CRCNEXT set right
+  *         after the last byte is written) and the byte received meanwhile
+  *         is checked against the CRC of the received bytes.
+  * @param  TxBuffer : bytes to send, or 0 to send SPI_DUMMY_BYTE.
+  * @param  RxBuffer : received bytes (CRC excluded), or 0 to discard them.
+  * @param  Length : number of data bytes, 1 to 65535; Length + 1 bytes are
+  *         transferred.
+  * @note   The SPI must be enabled, the polynomial is the one given to
+  *         SPI_Init(). The CRC calculation is disabled again on return.
+  * @retval ErrorStatus : ERROR if the received CRC does not match (CRCERR).
+  */
+ErrorStatus SPI_TransferFrame(const uint8_t* TxBuffer, uint8_t* RxBuffer, uint16_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint8_t data = SPI_DUMMY_BYTE, received = 0;
+
+  /* Check the parameters */
+  assert_param(IS_SPI_TRANSFER_LENGTH_OK(Length));
+
+  SPI_FrameCRCCmd(ENABLE);
+
+  /* Flush a byte left in DR */
+  (void)SPI->DR;
+  (void)SPI->SR;
+
+  if (TxBuffer != 0)
+  {
+    data = *TxBuffer++;
+  }
+  SPI->DR = data;
+  if (--Length == 0)
+  {
+    SPI->CR2 |= SPI_CR2_CRCNEXT;
+  }
+  while (Length != 0)
+  {
+    if (TxBuffer != 0)
+    {
+      data = *TxBuffer++;
+    }
+    while ((SPI->SR & SPI_SR_TXE) == 0)
+    {}
+    SPI->DR = data;
+    if (--Length == 0)
+    {
+      /* The CRC is sent right after the last byte */
+      SPI->CR2 |= SPI_CR2_CRCNEXT;
+    }
+    while ((SPI->SR & SPI_SR_RXNE) == 0)
+    {}
+    received = SPI->DR;
+    if (RxBuffer != 0)
+    {
+      *RxBuffer++ = received;
+    }
+  }
+
+  /* Last data byte, then the CRC of the peer */
+  while ((SPI->SR & SPI_SR_RXNE) == 0)
+  {}
+  received = SPI->DR;
+  if (RxBuffer != 0)
+  {
+    *RxBuffer = received;
+  }
+  while ((SPI->SR & SPI_SR_RXNE) == 0)
+  {}
+  (void)SPI->DR;
+
+  if ((SPI->SR & SPI_SR_CRCERR) != 0)
+  {
+    status = ERROR;
+  }
+
+  SPI_FrameCRCCmd(DISABLE);
+  SPI->SR = (uint8_t)(~SPI_SR_CRCERR);
+
+  return status;
+}
+#endif /* SPI_TRANSFER_SUPPORT */
+
 /**
   * @}
   */
@@ -1831,6 +1831,125 @@ void TIM1_SetCompare4(uint16_t Compare4)
   TIM1->CCR4L = (uint8_t)(Compare4);
 }
 
+#if defined (TIM1_MOTOR_PWM_SUPPORT)
+/**
+  * @brief  Configures the channels 1 to 3 for three phase motor control in
+  *         one pass, each register written once: center-aligned PWM mode 1
+  *         on OCx and OCxN (active high), compare registers preloaded, the
+  *         output enables and modes preloaded until a COM event, dead time
+  *         inserted, outputs idle low while MOE is clear.
+  * @param  TIM1_Prescaler specifies the counter clock prescaler, fCK_CNT = fMASTER / (TIM1_Prescaler + 1).
+  * @param  TIM1_Period specifies the PWM period in counts, the PWM frequency
+  *         being fCK_CNT / (2 * TIM1_Period) in center-aligned mode.
+  * @param  TIM1_DeadTime specifies the dead time value (DTR encoding, see
+  *         TIM1_BDTRConfig()).
+  * @param  TIM1_Break specifies the Break state @ref TIM1_BreakState_TypeDef.
+  * @param  TIM1_BreakPolarity specifies the Break polarity from
+  *         @ref TIM1_BreakPolarity_TypeDef.
+  * @par Required preconditions:
+  *         The counter is stopped and the outputs disabled on exit: the
+  *         duties are set with TIM1_SetDuty3(), then TIM1_MotorPWMCmd()
+  *         starts. The repetition counter gives one update event per PWM
+  *         period, at the underflow.
+  * @retval None
+  */
+void TIM1_MotorPWMInit(uint16_t TIM1_Prescaler, uint16_t TIM1_Period, uint8_t TIM1_DeadTime,
+                       TIM1_BreakState_TypeDef TIM1_Break, TIM1_BreakPolarity_TypeDef TIM1_BreakPolarity)
+{
+  /* Check the parameters */
+  assert_param(IS_TIM1_MOTOR_PERIOD_OK(TIM1_Period));
+  assert_param(IS_TIM1_BREAK_STATE_OK(TIM1_Break));
+  assert_param(IS_TIM1_BREAK_POLARITY_OK(TIM1_BreakPolarity));
+  
+  /* Stop the counter and disable the outputs */
+  TIM1->CR1 = 0;
+  TIM1->BKR = 0;
+  
+  TIM1->PSCRH = (uint8_t)(TIM1_Prescaler >> 8);
+  TIM1->PSCRL = (uint8_t)(TIM1_Prescaler);
+  TIM1->ARRH = (uint8_t)(TIM1_Period >> 8);
+  TIM1->ARRL = (uint8_t)(TIM1_Period);
+  TIM1->RCR = 1;
+  
+  /* PWM mode 1 with compare preload on the three phases */
+  TIM1->CCMR1 = (uint8_t)(TIM1_OCMODE_PWM1 | TIM1_CCMR_OCxPE);
+  TIM1->CCMR2 = (uint8_t)(TIM1_OCMODE_PWM1 | TIM1_CCMR_OCxPE);
+  TIM1->CCMR3 = (uint8_t)(TIM1_OCMODE_PWM1 | TIM1_CCMR_OCxPE);
+  TIM1->CCR1H = 0;
+  TIM1->CCR1L = 0;
+  TIM1->CCR2H = 0;
+  TIM1->CCR2L = 0;
+  TIM1->CCR3H = 0;
+  TIM1->CCR3L = 0;
+  
+  /* Complementary outputs enabled, active high, idle low */
+  TIM1->CCER1 = (uint8_t)(TIM1_CCER1_CC1E | TIM1_CCER1_CC1NE | TIM1_CCER1_CC2E | TIM1_CCER1_CC2NE);
+  TIM1->CCER2 = (uint8_t)(TIM1_CCER2_CC3E | TIM1_CCER2_CC3NE);
+  TIM1->OISR = 0;
+  TIM1->DTR = TIM1_DeadTime;
+  /* Outputs driven inactive, not floating, while MOE is clear */
+  TIM1->BKR = (uint8_t)(TIM1_BKR_OSSR | TIM1_BKR_OSSI | (uint8_t)TIM1_Break | (uint8_t)TIM1_BreakPolarity);
+  
+  /* CCxE, CCxNE and OCxM preloaded, transferred by COMG only */
+  TIM1->CR2 = TIM1_CR2_CCPC;
+  TIM1->CR1 = (uint8_t)(TIM1_CR1_ARPE | (uint8_t)TIM1_COUNTERMODE_CENTERALIGNED1);
+  
+  /* Load the prescaler, period, repetition counter and output controls */
+  TIM1->EGR = (uint8_t)(TIM1_EGR_UG | TIM1_EGR_COMG);
+  TIM1->SR1 = 0;
+}
+
+/**
+  * @brief  Starts or stops the three phase PWM.
+  * @param  NewState new state of the PWM: ENABLE starts the counter, then
+  *         sets MOE; DISABLE clears MOE, the outputs going to their idle
+  *         level after the dead time, then stops the counter.
+  * @retval None
+  */
+void TIM1_MotorPWMCmd(FunctionalState NewState)
+{
+  /* Check the parameters */
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  
+  if (NewState != DISABLE)
+  {
+    TIM1->CR1 |= TIM1_CR1_CEN;
+    TIM1->BKR |= TIM1_BKR_MOE;
+  }
+  else
+  {
+    TIM1->BKR &= (uint8_t)(~TIM1_BKR_MOE);
+    TIM1->CR1 &= (uint8_t)(~TIM1_CR1_CEN);
+  }
+}
+
+/**
+  * @brief  Sets the duties of the three phases, with 7 register writes and
+  *         no read-modify-write: the preloaded compare registers take effect
+  *         together at the next update event, and a COM event applies the
+  *         output enables and modes preloaded for six-step commutation
+  *         (TIM1_CCxCmd(), TIM1_CCxNCmd(), TIM1_SelectOCxM()).
+  * @param  Duty1 specifies the phase 1 compare value, 0 to TIM1_Period.
+  * @param  Duty2 specifies the phase 2 compare value, 0 to TIM1_Period.
+  * @param  Duty3 specifies the phase 3 compare value, 0 to TIM1_Period.
+  * @par Required preconditions:
+  *         TIM1_MotorPWMInit(). Called from the update interrupt, or early
+  *         in the period, so the three values load at the same update.
+  * @retval None
+  */
+void TIM1_SetDuty3(uint16_t Duty1, uint16_t Duty2, uint16_t Duty3)
+{
+  /* MSB first: the 16-bit preload is written with the LSB */
+  TIM1->CCR1H = (uint8_t)(Duty1 >> 8);
+  TIM1->CCR1L = (uint8_t)(Duty1);
+  TIM1->CCR2H = (uint8_t)(Duty2 >> 8);
+  TIM1->CCR2L = (uint8_t)(Duty2);
+  TIM1->CCR3H = (uint8_t)(Duty3 >> 8);
+  TIM1->CCR3L = (uint8_t)(Duty3);
+  TIM1->EGR = TIM1_EGR_COMG;
+}
+#endif /* TIM1_MOTOR_PWM_SUPPORT */
+
 /**
   * @brief  Sets the TIM1 Input Capture 1 prescaler.
   * @param   TIM1_IC1Prescaler specifies the Input Capture prescaler new value
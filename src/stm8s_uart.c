@@ -0,0 +1,820 @@
+/**
+  ********************************************************************************
+  * @file    stm8s_uart.c
+  * @author  MCD Application Team
+  * @version V2.2.0
+  * @date    30-September-2014
+  * @brief   This file contains the UART core shared by the UART1, UART2, UART3
+  *          and UART4 drivers. Every function works on the register block
+  *          given as first parameter so that a single copy is linked whatever
+  *          the number of UART instances used.
+   ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm8s_uart.h"
+
+/** @addtogroup STM8S_StdPeriph_Driver
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define UART_FLAG_RXNE ((uint16_t)0x0020) /*!< Read Data Register Not Empty flag */
+#define UART_IT_RXNE   ((uint16_t)0x0255) /*!< Receive interrupt */
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+/* Public functions ----------------------------------------------------------*/
+
+/** @}
+  * @addtogroup UART_Public_Functions
+  * @{
+  */
+
+/**
+  * @brief  Deinitializes the registers common to all the UART instances.
+  * @note   CR5, CR6, GTR and PSCR are reset by the UARTx drivers owning them.
+  * @param  UARTx: register block of the UART instance.
+  * @retval None
+  */
+void UART_DeInit(UART_TypeDef* UARTx)
+{
+  /* Clear the Idle Line Detected bit in the status register by a read
+  to the UART_SR register followed by a Read to the UART_DR register */
+  (void)UARTx->SR;
+  (void)UARTx->DR;
+
+  UARTx->BRR2 = (uint8_t)0x00;  /* Set UART_BRR2 to reset value 0x00 */
+  UARTx->BRR1 = (uint8_t)0x00;  /* Set UART_BRR1 to reset value 0x00 */
+
+  UARTx->CR1 = (uint8_t)0x00;  /* Set UART_CR1 to reset value 0x00 */
+  UARTx->CR2 = (uint8_t)0x00;  /* Set UART_CR2 to reset value 0x00 */
+  UARTx->CR3 = (uint8_t)0x00;  /* Set UART_CR3 to reset value 0x00 */
+  UARTx->CR4 = (uint8_t)0x00;  /* Set UART_CR4 to reset value 0x00 */
+}
+
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
+/**
+  * @brief  Initializes a UART instance according to the specified parameters.
+  * @note   The baud rate registers are computed from CLK_GetClockFreq(), use
+  *         UART_InitBRR() with precomputed values to avoid the 32-bit division.
+  * @param  UARTx: register block of the UART instance.
+  * @param  BaudRate: The baudrate.
+  * @param  WordLength: CR1 word length bit, UARTx_WordLength_TypeDef value.
+  * @param  StopBits: CR3 stop bits, UARTx_StopBits_TypeDef value.
+  * @param  Parity: CR1 parity bits, UARTx_Parity_TypeDef value.
+  * @param  SyncMode: UARTx_SyncMode_TypeDef value, or UART_SYNCMODE_NONE for
+  *         the instances without synchronous mode.
+  * @param  Mode: UARTx_Mode_TypeDef value.
+  * @retval None
+  */
+void UART_Init(UART_TypeDef* UARTx, uint32_t BaudRate, uint8_t WordLength,
+               uint8_t StopBits, uint8_t Parity, uint8_t SyncMode, uint8_t Mode)
+{
+  uint16_t uartdiv = 0;
+
+  /* UARTDIV = fMASTER / BaudRate, rounded to the nearest integer */
+  uartdiv = (uint16_t)UART_BRR_DIV(CLK_GetClockFreq(), BaudRate);
+
+  UART_InitBRR(UARTx, (uint8_t)(uartdiv >> 4),
+               (uint8_t)(((uint8_t)(uartdiv >> 8) & UART_BRR2_DIVM) |
+                         ((uint8_t)uartdiv & UART_BRR2_DIVF)),
+               WordLength, StopBits, Parity, SyncMode, Mode);
+}
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+
+/**
+  * @brief  Initializes a UART instance with precomputed baud rate registers.
+  * @note   The register values can be obtained at compile time with
+  *         UART_BRR1_FROM() and UART_BRR2_FROM(), or UARTx_BRR1_VALUE and
+  *         UARTx_BRR2_VALUE.
+  * @param  UARTx: register block of the UART instance.
+  * @param  BRR1: BRR1 register value, UARTDIV[11:4].
+  * @param  BRR2: BRR2 register value, UARTDIV[15:12] and UARTDIV[3:0].
+  * @param  WordLength: CR1 word length bit, UARTx_WordLength_TypeDef value.
+  * @param  StopBits: CR3 stop bits, UARTx_StopBits_TypeDef value.
+  * @param  Parity: CR1 parity bits, UARTx_Parity_TypeDef value.
+  * @param  SyncMode: UARTx_SyncMode_TypeDef value, or UART_SYNCMODE_NONE for
+  *         the instances without synchronous mode.
+  * @param  Mode: UARTx_Mode_TypeDef value.
+  * @retval None
+  */
+void UART_InitBRR(UART_TypeDef* UARTx, uint8_t BRR1, uint8_t BRR2, uint8_t WordLength,
+                  uint8_t StopBits, uint8_t Parity, uint8_t SyncMode, uint8_t Mode)
+{
+  /* Clear the word length and the Parity Control bits */
+  UARTx->CR1 &= (uint8_t)(~(UART_CR1_M | UART_CR1_PCEN | UART_CR1_PS));
+  /* Set the word length and the Parity Control bits */
+  UARTx->CR1 |= (uint8_t)(WordLength | Parity);
+
+  /* Clear the STOP bits */
+  UARTx->CR3 &= (uint8_t)(~UART_CR3_STOP);
+  /* Set the STOP bits number according to StopBits value  */
+  UARTx->CR3 |= StopBits;
+
+  /* The fraction and MSB mantissa should be loaded in one step in the BRR2
+     register, BRR2 must be written before BRR1 */
+  UARTx->BRR2 = BRR2;
+  UARTx->BRR1 = BRR1;
+
+  if (SyncMode != UART_SYNCMODE_NONE)
+  {
+    /* Disable the Transmitter and Receiver before setting the LBCL, CPOL and CPHA bits */
+    UARTx->CR2 &= (uint8_t)~(UART_CR2_TEN | UART_CR2_REN);
+    /* Clear the Clock Polarity, lock Phase, Last Bit Clock pulse */
+    UARTx->CR3 &= (uint8_t)~(UART_CR3_CPOL | UART_CR3_CPHA | UART_CR3_LBCL);
+    /* Set the Clock Polarity, lock Phase, Last Bit Clock pulse */
+    UARTx->CR3 |= (uint8_t)(SyncMode & (uint8_t)(UART_CR3_CPOL |
+                                                 UART_CR3_CPHA | UART_CR3_LBCL));
+  }
+
+  if ((uint8_t)(Mode & UART_MODE_TX_ENABLE))
+  {
+    /* Set the Transmitter Enable bit */
+    UARTx->CR2 |= UART_CR2_TEN;
+  }
+  else
+  {
+    /* Clear the Transmitter Disable bit */
+    UARTx->CR2 &= (uint8_t)(~UART_CR2_TEN);
+  }
+  if ((uint8_t)(Mode & UART_MODE_RX_ENABLE))
+  {
+    /* Set the Receiver Enable bit */
+    UARTx->CR2 |= UART_CR2_REN;
+  }
+  else
+  {
+    /* Clear the Receiver Disable bit */
+    UARTx->CR2 &= (uint8_t)(~UART_CR2_REN);
+  }
+
+  if (SyncMode != UART_SYNCMODE_NONE)
+  {
+    /* Set the Clock Enable bit according to SyncMode value */
+    if ((uint8_t)(SyncMode & UART_SYNCMODE_CLOCK_DISABLE))
+    {
+      /* Clear the Clock Enable bit */
+      UARTx->CR3 &= (uint8_t)(~UART_CR3_CKEN);
+    }
+    else
+    {
+      UARTx->CR3 |= (uint8_t)(SyncMode & UART_CR3_CKEN);
+    }
+  }
+}
+
+/**
+  * @brief  Enables or disables a UART instance.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the UART Communication.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_Cmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    /* UART Enable */
+    UARTx->CR1 &= (uint8_t)(~UART_CR1_UARTD);
+  }
+  else
+  {
+    /* UART Disable */
+    UARTx->CR1 |= UART_CR1_UARTD;
+  }
+}
+
+/**
+  * @brief  Enables or disables the specified UART interrupts.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_IT: UARTx_IT_TypeDef value; bits [11:8] give the control
+  *         register (1: CR1, 2: CR2, 3: CR4, 4: CR6) and bits [3:0] the
+  *         position of the enable bit.
+  * @param  NewState: new state of the specified UART interrupts.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_ITConfig(UART_TypeDef* UARTx, uint16_t UART_IT, FunctionalState NewState)
+{
+  __IO uint8_t* uartreg;
+  uint8_t itpos = 0x00;
+
+  /* Get the UART register */
+  switch ((uint8_t)(UART_IT >> 0x08))
+  {
+  case 0x01:
+    uartreg = &UARTx->CR1;
+    break;
+  case 0x02:
+    uartreg = &UARTx->CR2;
+    break;
+  case 0x03:
+    uartreg = &UARTx->CR4;
+    break;
+  default:
+    uartreg = &UARTx->CR6;
+    break;
+  }
+  /* Get the UART IT index */
+  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART_IT & (uint8_t)0x0F));
+
+  if (NewState != DISABLE)
+  {
+    /* Enable the Interrupt bits according to UART_IT mask */
+    *uartreg |= itpos;
+  }
+  else
+  {
+    /* Disable the interrupt bits according to UART_IT mask */
+    *uartreg &= (uint8_t)(~itpos);
+  }
+}
+
+/**
+  * @brief  Enables or disables the UART Half Duplex communication.
+  * @note   Only available on UART1 and UART4.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the UART Communication.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_HalfDuplexCmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    UARTx->CR5 |= UART_CR5_HDSEL;  /**< UART Half Duplex Enable  */
+  }
+  else
+  {
+    UARTx->CR5 &= (uint8_t)~UART_CR5_HDSEL; /**< UART Half Duplex Disable */
+  }
+}
+
+#if defined (UART_IRDA_SUPPORT)
+/**
+  * @brief  Configures the UART IrDA interface.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_IrDAMode: UARTx_IrDAMode_TypeDef value.
+  * @retval None
+  */
+void UART_IrDAConfig(UART_TypeDef* UARTx, uint8_t UART_IrDAMode)
+{
+  if (UART_IrDAMode != (uint8_t)0x00)
+  {
+    UARTx->CR5 |= UART_CR5_IRLP;
+  }
+  else
+  {
+    UARTx->CR5 &= ((uint8_t)~UART_CR5_IRLP);
+  }
+}
+
+/**
+  * @brief  Enables or disables the UART IrDA interface.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the IrDA mode.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_IrDACmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    /* Enable the IrDA mode by setting the IREN bit in the CR5 register */
+    UARTx->CR5 |= UART_CR5_IREN;
+  }
+  else
+  {
+    /* Disable the IrDA mode by clearing the IREN bit in the CR5 register */
+    UARTx->CR5 &= ((uint8_t)~UART_CR5_IREN);
+  }
+}
+#endif /* UART_IRDA_SUPPORT */
+
+#if defined (UART_LIN_SUPPORT)
+/**
+  * @brief  Sets the UART LIN Break detection length.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_LINBreakDetectionLength: UARTx_LINBreakDetectionLength_TypeDef value.
+  * @retval None
+  */
+void UART_LINBreakDetectionConfig(UART_TypeDef* UARTx, uint8_t UART_LINBreakDetectionLength)
+{
+  if (UART_LINBreakDetectionLength != (uint8_t)0x00)
+  {
+    UARTx->CR4 |= UART_CR4_LBDL;
+  }
+  else
+  {
+    UARTx->CR4 &= ((uint8_t)~UART_CR4_LBDL);
+  }
+}
+
+/**
+  * @brief  Enables or disables the UART LIN mode.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the UART LIN mode.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_LINCmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    /* Enable the LIN mode by setting the LINEN bit in the CR3 register */
+    UARTx->CR3 |= UART_CR3_LINEN;
+  }
+  else
+  {
+    /* Disable the LIN mode by clearing the LINEN bit in the CR3 register */
+    UARTx->CR3 &= ((uint8_t)~UART_CR3_LINEN);
+  }
+}
+
+#if defined (UART_CR6_PRESENT)
+/**
+  * @brief  Configures the UART LIN master/slave mode.
+  * @note   Only available on UART2, UART3 and UART4.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_Mode: UARTx_LinMode_TypeDef value.
+  * @param  UART_Autosync: UARTx_LinAutosync_TypeDef value.
+  * @param  UART_DivUp: UARTx_LinDivUp_TypeDef value.
+  * @retval None
+  */
+void UART_LINConfig(UART_TypeDef* UARTx, uint8_t UART_Mode, uint8_t UART_Autosync,
+                    uint8_t UART_DivUp)
+{
+  uint8_t cr6 = (uint8_t)(UARTx->CR6 & (uint8_t)~(UART_CR6_LSLV | UART_CR6_LASE |
+                                                  UART_CR6_LDUM));
+
+  if (UART_Mode != (uint8_t)0x00)
+  {
+    cr6 |= UART_CR6_LSLV;
+  }
+  if (UART_Autosync != (uint8_t)0x00)
+  {
+    cr6 |= UART_CR6_LASE;
+  }
+  if (UART_DivUp != (uint8_t)0x00)
+  {
+    cr6 |= UART_CR6_LDUM;
+  }
+
+  UARTx->CR6 = cr6;
+}
+#endif /* UART_CR6_PRESENT */
+#endif /* UART_LIN_SUPPORT */
+
+#if defined (UART_SMARTCARD_SUPPORT)
+/**
+  * @brief  Enables or disables the UART Smart Card mode.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the Smart Card mode.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_SmartCardCmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    /* Enable the SC mode by setting the SCEN bit in the CR5 register */
+    UARTx->CR5 |= UART_CR5_SCEN;
+  }
+  else
+  {
+    /* Disable the SC mode by clearing the SCEN bit in the CR5 register */
+    UARTx->CR5 &= ((uint8_t)(~UART_CR5_SCEN));
+  }
+}
+
+/**
+  * @brief  Enables or disables NACK transmission.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the Smart Card NACK transmission.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_SmartCardNACKCmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    /* Enable the NACK transmission by setting the NACK bit in the CR5 register */
+    UARTx->CR5 |= UART_CR5_NACK;
+  }
+  else
+  {
+    /* Disable the NACK transmission by clearing the NACK bit in the CR5 register */
+    UARTx->CR5 &= ((uint8_t)~(UART_CR5_NACK));
+  }
+}
+#endif /* UART_SMARTCARD_SUPPORT */
+
+/**
+  * @brief  Selects the UART WakeUp method.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_WakeUp: UARTx_WakeUp_TypeDef value.
+  * @retval None
+  */
+void UART_WakeUpConfig(UART_TypeDef* UARTx, uint8_t UART_WakeUp)
+{
+  UARTx->CR1 &= ((uint8_t)~UART_CR1_WAKE);
+  UARTx->CR1 |= UART_WakeUp;
+}
+
+/**
+  * @brief  Determines if the UART is in mute mode or not.
+  * @param  UARTx: register block of the UART instance.
+  * @param  NewState: new state of the UART mode.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_ReceiverWakeUpCmd(UART_TypeDef* UARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    /* Enable the mute mode by setting the RWU bit in the CR2 register */
+    UARTx->CR2 |= UART_CR2_RWU;
+  }
+  else
+  {
+    /* Disable the mute mode by clearing the RWU bit in the CR2 register */
+    UARTx->CR2 &= ((uint8_t)~UART_CR2_RWU);
+  }
+}
+
+/**
+  * @brief  Returns the most recent 9-bit data received by a UART instance.
+  * @param  UARTx: register block of the UART instance.
+  * @retval The received data.
+  */
+uint16_t UART_ReceiveData9(UART_TypeDef* UARTx)
+{
+  uint16_t temp = 0;
+
+  temp = (uint16_t)(((uint16_t)( (uint16_t)UARTx->CR1 & (uint16_t)UART_CR1_R8)) << 1);
+  return (uint16_t)( (((uint16_t) UARTx->DR) | temp ) & ((uint16_t)0x01FF));
+}
+
+/**
+  * @brief  Transmits 9 bit data through a UART instance.
+  * @param  UARTx: register block of the UART instance.
+  * @param  Data: The data to transmit.
+  *         This parameter should be lower than 0x1FF.
+  * @retval None
+  */
+void UART_SendData9(UART_TypeDef* UARTx, uint16_t Data)
+{
+  /**< Clear the transmit data bit 8 [8]  */
+  UARTx->CR1 &= ((uint8_t)~UART_CR1_T8);
+  /**< Write the transmit data bit [8]  */
+  UARTx->CR1 |= (uint8_t)(((uint8_t)(Data >> 2)) & UART_CR1_T8);
+  /**< Write the transmit data bit [0:7] */
+  UARTx->DR   = (uint8_t)(Data);
+}
+
+/**
+  * @brief  Sets the address of the UART node.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_Address: Indicates the address of the UART node.
+  * @retval None
+  */
+void UART_SetAddress(UART_TypeDef* UARTx, uint8_t UART_Address)
+{
+  /* Clear the UART address */
+  UARTx->CR4 &= ((uint8_t)~UART_CR4_ADD);
+  /* Set the UART address node */
+  UARTx->CR4 |= UART_Address;
+}
+
+/**
+  * @brief  Checks whether the specified UART flag is set or not.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_FLAG: UARTx_Flag_TypeDef value; bits [11:8] give the register
+  *         holding the flag (0: SR, 1: CR2, 2: CR4, 3: CR6).
+  * @retval FlagStatus (SET or RESET)
+  */
+FlagStatus UART_GetFlagStatus(UART_TypeDef* UARTx, uint16_t UART_FLAG)
+{
+  uint8_t uartreg = 0;
+
+  /* Get the register holding the flag */
+  switch ((uint8_t)(UART_FLAG >> 0x08))
+  {
+  case 0x00:
+    uartreg = UARTx->SR;
+    break;
+  case 0x01:
+    uartreg = UARTx->CR2;
+    break;
+  case 0x02:
+    uartreg = UARTx->CR4;
+    break;
+  default:
+    uartreg = UARTx->CR6;
+    break;
+  }
+
+  /* Return the UART_FLAG status*/
+  if ((uartreg & (uint8_t)UART_FLAG) != (uint8_t)0x00)
+  {
+    return SET;
+  }
+  return RESET;
+}
+
+/**
+  * @brief  Clears the UART flags.
+  * @note   Only RXNE (SR) and the LIN flags LBDF (CR4), LHDF and LSF (CR6) can
+  *         be cleared by software.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_FLAG: UARTx_Flag_TypeDef value.
+  * @retval None
+  */
+void UART_ClearFlag(UART_TypeDef* UARTx, uint16_t UART_FLAG)
+{
+  /* Clear the Receive Register Not Empty flag */
+  if (UART_FLAG == UART_FLAG_RXNE)
+  {
+    UARTx->SR = (uint8_t)~(UART_SR_RXNE);
+  }
+  /* Clear the LIN Break Detection flag */
+  else if ((uint8_t)(UART_FLAG >> 0x08) == (uint8_t)0x02)
+  {
+    UARTx->CR4 &= (uint8_t)~(UART_CR4_LBDF);
+  }
+  /* Clear the LIN Header Detection or LIN Synch Field flag */
+  else
+  {
+    UARTx->CR6 &= (uint8_t)~((uint8_t)UART_FLAG);
+  }
+}
+
+/**
+  * @brief  Checks whether the specified UART interrupt has occurred or not.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_IT: UARTx_IT_TypeDef value; bits [11:8] give the control
+  *         register, bits [7:4] the flag position and bits [3:0] the enable
+  *         bit position.
+  * @retval The new state of UART_IT (SET or RESET).
+  */
+ITStatus UART_GetITStatus(UART_TypeDef* UARTx, uint16_t UART_IT)
+{
+  uint8_t itpos = 0;
+  uint8_t itmask = 0;
+  uint8_t enablestatus = 0;
+  uint8_t flagstatus = 0;
+
+  /* Get the UART IT index */
+  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART_IT & (uint8_t)0x0F));
+  /* Set the IT mask*/
+  itmask = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART_IT >> (uint8_t)4));
+
+  /* Get the enable bit and the pending bit registers */
+  switch ((uint8_t)(UART_IT >> 0x08))
+  {
+  case 0x01:
+    enablestatus = UARTx->CR1;
+    flagstatus = UARTx->SR;
+    break;
+  case 0x02:
+    enablestatus = UARTx->CR2;
+    flagstatus = UARTx->SR;
+    break;
+  case 0x03:
+    enablestatus = UARTx->CR4;
+    flagstatus = enablestatus;
+    break;
+  default:
+    enablestatus = UARTx->CR6;
+    flagstatus = enablestatus;
+    break;
+  }
+
+  /* Check the status of the specified UART interrupt*/
+  if (((flagstatus & itpos) != (uint8_t)0x00) && ((enablestatus & itmask) != (uint8_t)0x00))
+  {
+    /* Interrupt occurred*/
+    return SET;
+  }
+  /* Interrupt not occurred*/
+  return RESET;
+}
+
+/**
+  * @brief  Clears the UART pending flags.
+  * @note   Only RXNE (SR) and the LIN pending bits LBDF (CR4) and LHDF (CR6)
+  *         can be cleared by software.
+  * @param  UARTx: register block of the UART instance.
+  * @param  UART_IT: UARTx_IT_TypeDef value.
+  * @retval None
+  */
+void UART_ClearITPendingBit(UART_TypeDef* UARTx, uint16_t UART_IT)
+{
+  /* Clear the Receive Register Not Empty pending bit */
+  if (UART_IT == UART_IT_RXNE)
+  {
+    UARTx->SR = (uint8_t)~(UART_SR_RXNE);
+  }
+  /* Clear the LIN Break Detection pending bit */
+  else if ((uint8_t)(UART_IT >> 0x08) == (uint8_t)0x03)
+  {
+    UARTx->CR4 &= (uint8_t)~(UART_CR4_LBDF);
+  }
+  /* Clear the LIN Header Detection pending bit */
+  else
+  {
+    UARTx->CR6 &= (uint8_t)~((uint8_t)1 << (uint8_t)((uint8_t)UART_IT >> (uint8_t)4));
+  }
+}
+
+#if defined (UART_BUFFER_SUPPORT)
+/**
+  * @brief  Enables or disables the interrupt driven buffers of a UART instance.
+  * @note   Both ring buffers are flushed. When enabled, the receiver interrupt
+  *         is turned on so that incoming bytes are stored by UART_RxISR();
+  *         the transmitter interrupt is turned on by UART_Write() on demand.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @param  NewState: new state of the UART buffers.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART_BufferCmd(UART_Buffer_TypeDef* UART_Buffer, FunctionalState NewState)
+{
+  UART_TypeDef* UARTx = UART_Buffer->UARTx;
+
+  /* Stop both interrupts while the indexes are reset */
+  UARTx->CR2 &= (uint8_t)~(UART_CR2_TIEN | UART_CR2_RIEN);
+
+  UART_Buffer->TxHead = 0;
+  UART_Buffer->TxTail = 0;
+  UART_Buffer->RxHead = 0;
+  UART_Buffer->RxTail = 0;
+
+  if (NewState != DISABLE)
+  {
+    /* Receive interrupt also fires on OverRun, which is cleared by UART_RxISR() */
+    UARTx->CR2 |= UART_CR2_RIEN;
+  }
+}
+
+/**
+  * @brief  Queues data for interrupt driven transmission.
+  * @note   This function never waits: only the bytes that fit in the free
+  *         space of the transmit buffer are queued.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @param  Buffer: pointer to the data to transmit.
+  * @param  Length: number of bytes to transmit.
+  * @retval The number of bytes actually queued.
+  */
+uint8_t UART_Write(UART_Buffer_TypeDef* UART_Buffer, const uint8_t* Buffer, uint8_t Length)
+{
+  uint8_t head = UART_Buffer->TxHead;
+  uint8_t mask = UART_Buffer->TxMask;
+  uint8_t count = 0;
+
+  while ((count < Length) && ((uint8_t)(head - UART_Buffer->TxTail) <= mask))
+  {
+    UART_Buffer->TxBuffer[head & mask] = Buffer[count];
+    head++;
+    count++;
+  }
+
+  if (count != 0)
+  {
+    /* Publish the new bytes before the interrupt can fetch them */
+    UART_Buffer->TxHead = head;
+    UART_Buffer->UARTx->CR2 |= UART_CR2_TIEN;
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Fetches the received data from the receive buffer.
+  * @note   This function never waits: only the bytes already received
+  *         are returned.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @param  Buffer: pointer to the destination buffer.
+  * @param  Length: maximum number of bytes to read.
+  * @retval The number of bytes actually read.
+  */
+uint8_t UART_Read(UART_Buffer_TypeDef* UART_Buffer, uint8_t* Buffer, uint8_t Length)
+{
+  uint8_t tail = UART_Buffer->RxTail;
+  uint8_t mask = UART_Buffer->RxMask;
+  uint8_t count = 0;
+
+  while ((count < Length) && (tail != UART_Buffer->RxHead))
+  {
+    Buffer[count] = UART_Buffer->RxBuffer[tail & mask];
+    tail++;
+    count++;
+  }
+
+  /* Release the space to the interrupt */
+  UART_Buffer->RxTail = tail;
+
+  return count;
+}
+
+/**
+  * @brief  Returns the number of received bytes waiting in the receive buffer.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @retval Number of bytes available to UART_Read().
+  */
+uint8_t UART_GetRxCount(UART_Buffer_TypeDef* UART_Buffer)
+{
+  return (uint8_t)(UART_Buffer->RxHead - UART_Buffer->RxTail);
+}
+
+/**
+  * @brief  Returns the free space left in the transmit buffer.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @retval Number of bytes UART_Write() can accept without truncation.
+  */
+uint8_t UART_GetTxFree(UART_Buffer_TypeDef* UART_Buffer)
+{
+  return (uint8_t)((uint8_t)(UART_Buffer->TxMask + 1) -
+                   (uint8_t)(UART_Buffer->TxHead - UART_Buffer->TxTail));
+}
+
+/**
+  * @brief  Feeds the UART transmitter from the transmit buffer.
+  * @note   To be called from the UART TX interrupt routine. The transmitter
+  *         interrupt is disabled as soon as the last byte is loaded.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @retval None
+  */
+void UART_TxISR(UART_Buffer_TypeDef* UART_Buffer)
+{
+  uint8_t tail = UART_Buffer->TxTail;
+
+  if (tail != UART_Buffer->TxHead)
+  {
+    UART_Buffer->UARTx->DR = UART_Buffer->TxBuffer[tail & UART_Buffer->TxMask];
+    tail++;
+    UART_Buffer->TxTail = tail;
+  }
+
+  if (tail == UART_Buffer->TxHead)
+  {
+    /* Nothing left: UART_Write() enables the interrupt again */
+    UART_Buffer->UARTx->CR2 &= (uint8_t)(~UART_CR2_TIEN);
+  }
+}
+
+/**
+  * @brief  Stores the received byte into the receive buffer.
+  * @note   To be called from the UART RX interrupt routine. The byte is
+  *         dropped when the receive buffer is full.
+  * @param  UART_Buffer: buffers of the UART instance.
+  * @retval None
+  */
+void UART_RxISR(UART_Buffer_TypeDef* UART_Buffer)
+{
+  uint8_t head = UART_Buffer->RxHead;
+  uint8_t data = 0;
+
+  /* A read to SR followed by a read to DR clears RXNE and the OR, NF, FE
+     and PE error flags */
+  (void)UART_Buffer->UARTx->SR;
+  data = UART_Buffer->UARTx->DR;
+
+  if ((uint8_t)(head - UART_Buffer->RxTail) <= UART_Buffer->RxMask)
+  {
+    UART_Buffer->RxBuffer[head & UART_Buffer->RxMask] = data;
+    UART_Buffer->RxHead = (uint8_t)(head + 1);
+  }
+}
+#endif /* UART_BUFFER_SUPPORT */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -34,8 +34,29 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+#if !IS_UART_BUFFER_SIZE_OK(UART1_TX_BUFFER_SIZE)
+ #error "UART1_TX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if !IS_UART_BUFFER_SIZE_OK(UART1_RX_BUFFER_SIZE)
+ #error "UART1_RX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#endif /* UART_BUFFER_SUPPORT */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+static uint8_t UART1_TxBuffer[UART1_TX_BUFFER_SIZE];
+static uint8_t UART1_RxBuffer[UART1_RX_BUFFER_SIZE];
+static UART_Buffer_TypeDef UART1_Buffer =
+{
+  UART1_CORE,
+  UART1_TxBuffer,
+  UART1_RxBuffer,
+  (uint8_t)(UART1_TX_BUFFER_SIZE - 1),
+  (uint8_t)(UART1_RX_BUFFER_SIZE - 1),
+  0, 0, 0, 0
+};
+#endif /* UART_BUFFER_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 /* Public functions ----------------------------------------------------------*/
@@ -52,24 +73,15 @@
 	*/
 void UART1_DeInit(void)
 {
-  /* Clear the Idle Line Detected bit in the status register by a read
-  to the UART1_SR register followed by a Read to the UART1_DR register */
-  (void)UART1->SR;
-  (void)UART1->DR;
-  
-  UART1->BRR2 = UART1_BRR2_RESET_VALUE;  /* Set UART1_BRR2 to reset value 0x00 */
-  UART1->BRR1 = UART1_BRR1_RESET_VALUE;  /* Set UART1_BRR1 to reset value 0x00 */
+  UART_DeInit(UART1_CORE);
   
-  UART1->CR1 = UART1_CR1_RESET_VALUE;  /* Set UART1_CR1 to reset value 0x00 */
-  UART1->CR2 = UART1_CR2_RESET_VALUE;  /* Set UART1_CR2 to reset value 0x00 */
-  UART1->CR3 = UART1_CR3_RESET_VALUE;  /* Set UART1_CR3 to reset value 0x00 */
-  UART1->CR4 = UART1_CR4_RESET_VALUE;  /* Set UART1_CR4 to reset value 0x00 */
   UART1->CR5 = UART1_CR5_RESET_VALUE;  /* Set UART1_CR5 to reset value 0x00 */
   
   UART1->GTR = UART1_GTR_RESET_VALUE;
   UART1->PSCR = UART1_PSCR_RESET_VALUE;
 }
 
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 /**
   * @brief  Initializes the UART1 according to the specified parameters.
   * @note   Configure in Push Pull or Open Drain mode the Tx pin by setting the
@@ -91,8 +103,6 @@ void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength,
                 UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
                 UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode)
 {
-  uint32_t BaudRate_Mantissa = 0, BaudRate_Mantissa100 = 0;
-  
   /* Check the parameters */
   assert_param(IS_UART1_BAUDRATE_OK(BaudRate));
   assert_param(IS_UART1_WORDLENGTH_OK(WordLength));
@@ -101,78 +111,42 @@ void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength,
   assert_param(IS_UART1_MODE_OK((uint8_t)Mode));
   assert_param(IS_UART1_SYNCMODE_OK((uint8_t)SyncMode));
   
-  /* Clear the word length bit */
-  UART1->CR1 &= (uint8_t)(~UART1_CR1_M);  
-  
-  /* Set the word length bit according to UART1_WordLength value */
-  UART1->CR1 |= (uint8_t)WordLength;
-  
-  /* Clear the STOP bits */
-  UART1->CR3 &= (uint8_t)(~UART1_CR3_STOP);  
-  /* Set the STOP bits number according to UART1_StopBits value  */
-  UART1->CR3 |= (uint8_t)StopBits;  
-  
-  /* Clear the Parity Control bit */
-  UART1->CR1 &= (uint8_t)(~(UART1_CR1_PCEN | UART1_CR1_PS  ));  
-  /* Set the Parity Control bit to UART1_Parity value */
-  UART1->CR1 |= (uint8_t)Parity;  
-  
-  /* Clear the LSB mantissa of UART1DIV  */
-  UART1->BRR1 &= (uint8_t)(~UART1_BRR1_DIVM);  
-  /* Clear the MSB mantissa of UART1DIV  */
-  UART1->BRR2 &= (uint8_t)(~UART1_BRR2_DIVM);  
-  /* Clear the Fraction bits of UART1DIV */
-  UART1->BRR2 &= (uint8_t)(~UART1_BRR2_DIVF);  
-  
-  /* Set the UART1 BaudRates in BRR1 and BRR2 registers according to UART1_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  /* Set the fraction of UART1DIV  */
-  UART1->BRR2 |= (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100)) << 4) / 100) & (uint8_t)0x0F); 
-  /* Set the MSB mantissa of UART1DIV  */
-  UART1->BRR2 |= (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0); 
-  /* Set the LSB mantissa of UART1DIV  */
-  UART1->BRR1 |= (uint8_t)BaudRate_Mantissa;           
-  
-  /* Disable the Transmitter and Receiver before setting the LBCL, CPOL and CPHA bits */
-  UART1->CR2 &= (uint8_t)~(UART1_CR2_TEN | UART1_CR2_REN); 
-  /* Clear the Clock Polarity, lock Phase, Last Bit Clock pulse */
-  UART1->CR3 &= (uint8_t)~(UART1_CR3_CPOL | UART1_CR3_CPHA | UART1_CR3_LBCL); 
-  /* Set the Clock Polarity, lock Phase, Last Bit Clock pulse */
-  UART1->CR3 |= (uint8_t)((uint8_t)SyncMode & (uint8_t)(UART1_CR3_CPOL | 
-                                                        UART1_CR3_CPHA | UART1_CR3_LBCL));  
+  UART_Init(UART1_CORE, BaudRate, (uint8_t)WordLength, (uint8_t)StopBits,
+            (uint8_t)Parity, (uint8_t)SyncMode, (uint8_t)Mode);
+}
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+
+/**
+  * @brief  Initializes the UART1 with precomputed baud rate registers.
+  * @note   This function does not use CLK_GetClockFreq() nor any 32-bit
+  *         division: the register values are given by UART_BRR1_FROM() and
+  *         UART_BRR2_FROM(), or by UART1_BRR1_VALUE and UART1_BRR2_VALUE.
+  * @param  BRR1: BRR1 register value.
+  * @param  BRR2: BRR2 register value.
+  * @param  WordLength : This parameter can be any of the 
+  *         @ref UART1_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART1_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART1_Parity_TypeDef enumeration.
+  * @param  SyncMode: This parameter can be any of the 
+  *         @ref UART1_SyncMode_TypeDef values.
+  * @param  Mode: This parameter can be any of the @ref UART1_Mode_TypeDef values
+  * @retval None
+  */
+void UART1_InitBRR(uint8_t BRR1, uint8_t BRR2, UART1_WordLength_TypeDef WordLength, 
+                   UART1_StopBits_TypeDef StopBits, UART1_Parity_TypeDef Parity, 
+                   UART1_SyncMode_TypeDef SyncMode, UART1_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART1_WORDLENGTH_OK(WordLength));
+  assert_param(IS_UART1_STOPBITS_OK(StopBits));
+  assert_param(IS_UART1_PARITY_OK(Parity));
+  assert_param(IS_UART1_MODE_OK((uint8_t)Mode));
+  assert_param(IS_UART1_SYNCMODE_OK((uint8_t)SyncMode));
   
-  if ((uint8_t)(Mode & UART1_MODE_TX_ENABLE))
-  {
-    /* Set the Transmitter Enable bit */
-    UART1->CR2 |= (uint8_t)UART1_CR2_TEN;  
-  }
-  else
-  {
-    /* Clear the Transmitter Disable bit */
-    UART1->CR2 &= (uint8_t)(~UART1_CR2_TEN);  
-  }
-  if ((uint8_t)(Mode & UART1_MODE_RX_ENABLE))
-  {
-    /* Set the Receiver Enable bit */
-    UART1->CR2 |= (uint8_t)UART1_CR2_REN;  
-  }
-  else
-  {
-    /* Clear the Receiver Disable bit */
-    UART1->CR2 &= (uint8_t)(~UART1_CR2_REN);  
-  }
-  /* Set the Clock Enable bit, lock Polarity, lock Phase and Last Bit Clock 
-  pulse bits according to UART1_Mode value */
-  if ((uint8_t)(SyncMode & UART1_SYNCMODE_CLOCK_DISABLE))
-  {
-    /* Clear the Clock Enable bit */
-    UART1->CR3 &= (uint8_t)(~UART1_CR3_CKEN); 
-  }
-  else
-  {
-    UART1->CR3 |= (uint8_t)((uint8_t)SyncMode & UART1_CR3_CKEN);
-  }
+  UART_InitBRR(UART1_CORE, BRR1, BRR2, (uint8_t)WordLength, (uint8_t)StopBits,
+               (uint8_t)Parity, (uint8_t)SyncMode, (uint8_t)Mode);
 }
 
 /**
@@ -183,16 +157,7 @@ void UART1_Init(uint32_t BaudRate, UART1_WordLength_TypeDef WordLength,
   */
 void UART1_Cmd(FunctionalState NewState)
 {
-  if (NewState != DISABLE)
-  {
-    /* UART1 Enable */
-    UART1->CR1 &= (uint8_t)(~UART1_CR1_UARTD); 
-  }
-  else
-  {
-    /* UART Disable */
-    UART1->CR1 |= UART1_CR1_UARTD;  
-  }
+  UART_Cmd(UART1_CORE, NewState);
 }
 
 /**
@@ -210,50 +175,11 @@ void UART1_Cmd(FunctionalState NewState)
   */
 void UART1_ITConfig(UART1_IT_TypeDef UART1_IT, FunctionalState NewState)
 {
-  uint8_t uartreg = 0, itpos = 0x00;
-  
   /* Check the parameters */
   assert_param(IS_UART1_CONFIG_IT_OK(UART1_IT));
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  /* Get the UART1 register index */
-  uartreg = (uint8_t)((uint16_t)UART1_IT >> 0x08);
-  /* Get the UART1 IT index */
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART1_IT & (uint8_t)0x0F));
-  
-  if (NewState != DISABLE)
-  {
-    /**< Enable the Interrupt bits according to UART1_IT mask */
-    if (uartreg == 0x01)
-    {
-      UART1->CR1 |= itpos;
-    }
-    else if (uartreg == 0x02)
-    {
-      UART1->CR2 |= itpos;
-    }
-    else
-    {
-      UART1->CR4 |= itpos;
-    }
-  }
-  else
-  {
-    /**< Disable the interrupt bits according to UART1_IT mask */
-    if (uartreg == 0x01)
-    {
-      UART1->CR1 &= (uint8_t)(~itpos);
-    }
-    else if (uartreg == 0x02)
-    {
-      UART1->CR2 &= (uint8_t)(~itpos);
-    }
-    else
-    {
-      UART1->CR4 &= (uint8_t)(~itpos);
-    }
-  }
-  
+  UART_ITConfig(UART1_CORE, (uint16_t)UART1_IT, NewState);
 }
 
 /**
@@ -266,16 +192,10 @@ void UART1_HalfDuplexCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    UART1->CR5 |= UART1_CR5_HDSEL;  /**< UART1 Half Duplex Enable  */
-  }
-  else
-  {
-    UART1->CR5 &= (uint8_t)~UART1_CR5_HDSEL; /**< UART1 Half Duplex Disable */
-  }
+  UART_HalfDuplexCmd(UART1_CORE, NewState);
 }
 
+#if defined (UART_IRDA_SUPPORT)
 /**
   * @brief  Configures the UARTs IrDA interface.
   * @param  UART1_IrDAMode specifies the IrDA mode.
@@ -286,14 +206,7 @@ void UART1_IrDAConfig(UART1_IrDAMode_TypeDef UART1_IrDAMode)
 {
   assert_param(IS_UART1_IRDAMODE_OK(UART1_IrDAMode));
   
-  if (UART1_IrDAMode != UART1_IRDAMODE_NORMAL)
-  {
-    UART1->CR5 |= UART1_CR5_IRLP;
-  }
-  else
-  {
-    UART1->CR5 &= ((uint8_t)~UART1_CR5_IRLP);
-  }
+  UART_IrDAConfig(UART1_CORE, (uint8_t)UART1_IrDAMode);
 }
 
 /**
@@ -307,18 +220,11 @@ void UART1_IrDACmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the IrDA mode by setting the IREN bit in the CR3 register */
-    UART1->CR5 |= UART1_CR5_IREN;
-  }
-  else
-  {
-    /* Disable the IrDA mode by clearing the IREN bit in the CR3 register */
-    UART1->CR5 &= ((uint8_t)~UART1_CR5_IREN);
-  }
+  UART_IrDACmd(UART1_CORE, NewState);
 }
+#endif /* UART_IRDA_SUPPORT */
 
+#if defined (UART_LIN_SUPPORT)
 /**
   * @brief  Sets the UART1 LIN Break detection length.
   * @param  UART1_LINBreakDetectionLength specifies the LIN break detection length.
@@ -330,14 +236,7 @@ void UART1_LINBreakDetectionConfig(UART1_LINBreakDetectionLength_TypeDef UART1_L
 {
   assert_param(IS_UART1_LINBREAKDETECTIONLENGTH_OK(UART1_LINBreakDetectionLength));
   
-  if (UART1_LINBreakDetectionLength != UART1_LINBREAKDETECTIONLENGTH_10BITS)
-  {
-    UART1->CR4 |= UART1_CR4_LBDL;
-  }
-  else
-  {
-    UART1->CR4 &= ((uint8_t)~UART1_CR4_LBDL);
-  }
+  UART_LINBreakDetectionConfig(UART1_CORE, (uint8_t)UART1_LINBreakDetectionLength);
 }
 
 /**
@@ -350,18 +249,11 @@ void UART1_LINCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the LIN mode by setting the LINE bit in the CR2 register */
-    UART1->CR3 |= UART1_CR3_LINEN;
-  }
-  else
-  {
-    /* Disable the LIN mode by clearing the LINE bit in the CR2 register */
-    UART1->CR3 &= ((uint8_t)~UART1_CR3_LINEN);
-  }
+  UART_LINCmd(UART1_CORE, NewState);
 }
+#endif /* UART_LIN_SUPPORT */
 
+#if defined (UART_SMARTCARD_SUPPORT)
 /**
   * @brief  Enables or disables the UART1 Smart Card mode.
   * @param  NewState: new state of the Smart Card mode.
@@ -372,16 +264,7 @@ void UART1_SmartCardCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the SC mode by setting the SCEN bit in the CR5 register */
-    UART1->CR5 |= UART1_CR5_SCEN;
-  }
-  else
-  {
-    /* Disable the SC mode by clearing the SCEN bit in the CR5 register */
-    UART1->CR5 &= ((uint8_t)(~UART1_CR5_SCEN));
-  }
+  UART_SmartCardCmd(UART1_CORE, NewState);
 }
 
 /**
@@ -395,17 +278,9 @@ void UART1_SmartCardNACKCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the NACK transmission by setting the NACK bit in the CR5 register */
-    UART1->CR5 |= UART1_CR5_NACK;
-  }
-  else
-  {
-    /* Disable the NACK transmission by clearing the NACK bit in the CR5 register */
-    UART1->CR5 &= ((uint8_t)~(UART1_CR5_NACK));
-  }
+  UART_SmartCardNACKCmd(UART1_CORE, NewState);
 }
+#endif /* UART_SMARTCARD_SUPPORT */
 
 /**
   * @brief  Selects the UART1 WakeUp method.
@@ -417,8 +292,7 @@ void UART1_WakeUpConfig(UART1_WakeUp_TypeDef UART1_WakeUp)
 {
   assert_param(IS_UART1_WAKEUP_OK(UART1_WakeUp));
   
-  UART1->CR1 &= ((uint8_t)~UART1_CR1_WAKE);
-  UART1->CR1 |= (uint8_t)UART1_WakeUp;
+  UART_WakeUpConfig(UART1_CORE, (uint8_t)UART1_WakeUp);
 }
 
 /**
@@ -431,16 +305,7 @@ void UART1_ReceiverWakeUpCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the mute mode UART1 by setting the RWU bit in the CR2 register */
-    UART1->CR2 |= UART1_CR2_RWU;
-  }
-  else
-  {
-    /* Disable the mute mode UART1 by clearing the RWU bit in the CR1 register */
-    UART1->CR2 &= ((uint8_t)~UART1_CR2_RWU);
-  }
+  UART_ReceiverWakeUpCmd(UART1_CORE, NewState);
 }
 
 /**
@@ -460,10 +325,7 @@ uint8_t UART1_ReceiveData8(void)
   */
 uint16_t UART1_ReceiveData9(void)
 {
-  uint16_t temp = 0;
-  
-  temp = (uint16_t)(((uint16_t)( (uint16_t)UART1->CR1 & (uint16_t)UART1_CR1_R8)) << 1);
-  return (uint16_t)( (((uint16_t) UART1->DR) | temp ) & ((uint16_t)0x01FF));
+  return UART_ReceiveData9(UART1_CORE);
 }
 
 /**
@@ -485,12 +347,7 @@ void UART1_SendData8(uint8_t Data)
   */
 void UART1_SendData9(uint16_t Data)
 {
-  /**< Clear the transmit data bit 8 [8]  */
-  UART1->CR1 &= ((uint8_t)~UART1_CR1_T8);
-  /**< Write the transmit data bit [8]  */
-  UART1->CR1 |= (uint8_t)(((uint8_t)(Data >> 2)) & UART1_CR1_T8);
-  /**< Write the transmit data bit [0:7] */
-  UART1->DR   = (uint8_t)(Data);
+  UART_SendData9(UART1_CORE, Data);
 }
 
 /**
@@ -513,12 +370,10 @@ void UART1_SetAddress(uint8_t UART1_Address)
   /*assert_param for UART1_Address*/
   assert_param(IS_UART1_ADDRESS_OK(UART1_Address));
   
-  /* Clear the UART1 address */
-  UART1->CR4 &= ((uint8_t)~UART1_CR4_ADD);
-  /* Set the UART1 address node */
-  UART1->CR4 |= UART1_Address;
+  UART_SetAddress(UART1_CORE, UART1_Address);
 }
 
+#if defined (UART_SMARTCARD_SUPPORT)
 /**
   * @brief  Sets the specified UART guard time.
   * @note   SmartCard Mode should be Enabled
@@ -530,7 +385,9 @@ void UART1_SetGuardTime(uint8_t UART1_GuardTime)
   /* Set the UART1 guard time */
   UART1->GTR = UART1_GuardTime;
 }
+#endif /* UART_SMARTCARD_SUPPORT */
 
+#if defined (UART_SMARTCARD_SUPPORT) || defined (UART_IRDA_SUPPORT)
 /**
   * @brief  Sets the system clock prescaler.
   * @note   IrDA Low Power mode or smartcard mode should be enabled
@@ -558,6 +415,7 @@ void UART1_SetPrescaler(uint8_t UART1_Prescaler)
   /* Load the UART1 prescaler value*/
   UART1->PSCR = UART1_Prescaler;
 }
+#endif /* UART_SMARTCARD_SUPPORT || UART_IRDA_SUPPORT */
 
 /**
   * @brief  Checks whether the specified UART1 flag is set or not.
@@ -567,54 +425,11 @@ void UART1_SetPrescaler(uint8_t UART1_Prescaler)
   */
 FlagStatus UART1_GetFlagStatus(UART1_Flag_TypeDef UART1_FLAG)
 {
-  FlagStatus status = RESET;
-  
   /* Check parameters */
   assert_param(IS_UART1_FLAG_OK(UART1_FLAG));
   
-  
-  /* Check the status of the specified UART1 flag*/
-  if (UART1_FLAG == UART1_FLAG_LBDF)
-  {
-    if ((UART1->CR4 & (uint8_t)UART1_FLAG) != (uint8_t)0x00)
-    {
-      /* UART1_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART1_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if (UART1_FLAG == UART1_FLAG_SBK)
-  {
-    if ((UART1->CR2 & (uint8_t)UART1_FLAG) != (uint8_t)0x00)
-    {
-      /* UART1_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART1_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else
-  {
-    if ((UART1->SR & (uint8_t)UART1_FLAG) != (uint8_t)0x00)
-    {
-      /* UART1_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART1_FLAG is reset*/
-      status = RESET;
-    }
-  }
   /* Return the UART1_FLAG status*/
-  return status;
+  return UART_GetFlagStatus(UART1_CORE, (uint16_t)UART1_FLAG);
 }
 
 /**
@@ -647,16 +462,7 @@ void UART1_ClearFlag(UART1_Flag_TypeDef UART1_FLAG)
 {
   assert_param(IS_UART1_CLEAR_FLAG_OK(UART1_FLAG));
   
-  /* Clear the Receive Register Not Empty flag */
-  if (UART1_FLAG == UART1_FLAG_RXNE)
-  {
-    UART1->SR = (uint8_t)~(UART1_SR_RXNE);
-  }
-  /* Clear the LIN Break Detection flag */
-  else
-  {
-    UART1->CR4 &= (uint8_t)~(UART1_CR4_LBDF);
-  }
+  UART_ClearFlag(UART1_CORE, (uint16_t)UART1_FLAG);
 }
 
 /**
@@ -674,77 +480,11 @@ void UART1_ClearFlag(UART1_Flag_TypeDef UART1_FLAG)
   */
 ITStatus UART1_GetITStatus(UART1_IT_TypeDef UART1_IT)
 {
-  ITStatus pendingbitstatus = RESET;
-  uint8_t itpos = 0;
-  uint8_t itmask1 = 0;
-  uint8_t itmask2 = 0;
-  uint8_t enablestatus = 0;
-  
   /* Check parameters */
   assert_param(IS_UART1_GET_IT_OK(UART1_IT));
   
-  /* Get the UART1 IT index */
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART1_IT & (uint8_t)0x0F));
-  /* Get the UART1 IT index */
-  itmask1 = (uint8_t)((uint8_t)UART1_IT >> (uint8_t)4);
-  /* Set the IT mask*/
-  itmask2 = (uint8_t)((uint8_t)1 << itmask1);
-  
-  
-  /* Check the status of the specified UART1 pending bit*/
-  if (UART1_IT == UART1_IT_PE)
-  {
-    /* Get the UART1_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART1->CR1 & itmask2);
-    /* Check the status of the specified UART1 interrupt*/
-    
-    if (((UART1->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  
-  else if (UART1_IT == UART1_IT_LBDF)
-  {
-    /* Get the UART1_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART1->CR4 & itmask2);
-    /* Check the status of the specified UART1 interrupt*/
-    if (((UART1->CR4 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else
-  {
-    /* Get the UART1_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART1->CR2 & itmask2);
-    /* Check the status of the specified UART1 interrupt*/
-    if (((UART1->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  
   /* Return the UART1_IT status*/
-  return  pendingbitstatus;
+  return UART_GetITStatus(UART1_CORE, (uint16_t)UART1_IT);
 }
 
 /**
@@ -776,17 +516,99 @@ void UART1_ClearITPendingBit(UART1_IT_TypeDef UART1_IT)
 {
   assert_param(IS_UART1_CLEAR_IT_OK(UART1_IT));
   
-  /* Clear the Receive Register Not Empty pending bit */
-  if (UART1_IT == UART1_IT_RXNE)
-  {
-    UART1->SR = (uint8_t)~(UART1_SR_RXNE);
-  }
-  /* Clear the LIN Break Detection pending bit */
-  else
-  {
-    UART1->CR4 &= (uint8_t)~(UART1_CR4_LBDF);
-  }
+  UART_ClearITPendingBit(UART1_CORE, (uint16_t)UART1_IT);
+}
+
+#if defined (UART_BUFFER_SUPPORT)
+/**
+  * @brief  Enables or disables the interrupt driven UART1 buffers.
+  * @note   Both ring buffers are flushed. When enabled, the receiver interrupt
+  *         is turned on so that incoming bytes are stored by UART1_RxISR();
+  *         the transmitter interrupt is turned on by UART1_Write() on demand.
+  * @note   UART1_TxISR() and UART1_RxISR() must be called from the UART1 TX
+  *         and RX interrupt routines and the buffers only carry 8-bit data.
+  * @note   The buffers are handled by the UART core, see UART_BufferCmd().
+  * @param  NewState: new state of the UART1 buffers.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART1_BufferCmd(FunctionalState NewState)
+{
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  
+  UART_BufferCmd(&UART1_Buffer, NewState);
+}
+
+/**
+  * @brief  Queues data for interrupt driven transmission through UART1.
+  * @note   This function never waits: only the bytes that fit in the free
+  *         space of the transmit buffer are queued.
+  * @param  Buffer: pointer to the data to transmit.
+  * @param  Length: number of bytes to transmit.
+  * @retval The number of bytes actually queued.
+  */
+uint8_t UART1_Write(const uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Write(&UART1_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Fetches the data received by UART1 from the receive buffer.
+  * @note   This function never waits: only the bytes already received
+  *         are returned.
+  * @param  Buffer: pointer to the destination buffer.
+  * @param  Length: maximum number of bytes to read.
+  * @retval The number of bytes actually read.
+  */
+uint8_t UART1_Read(uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Read(&UART1_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Returns the number of received bytes waiting in the receive buffer.
+  * @param  None
+  * @retval Number of bytes available to UART1_Read().
+  */
+uint8_t UART1_GetRxCount(void)
+{
+  return UART_GetRxCount(&UART1_Buffer);
+}
+
+/**
+  * @brief  Returns the free space left in the transmit buffer.
+  * @param  None
+  * @retval Number of bytes UART1_Write() can accept without truncation.
+  */
+uint8_t UART1_GetTxFree(void)
+{
+  return UART_GetTxFree(&UART1_Buffer);
+}
+
+/**
+  * @brief  Feeds the UART1 transmitter from the transmit buffer.
+  * @note   To be called from the UART1 TX interrupt routine. The transmitter
+  *         interrupt is disabled as soon as the last byte is loaded.
+  * @param  None
+  * @retval None
+  */
+void UART1_TxISR(void)
+{
+  UART_TxISR(&UART1_Buffer);
+}
+
+/**
+  * @brief  Stores the byte received by UART1 into the receive buffer.
+  * @note   To be called from the UART1 RX interrupt routine. The byte is
+  *         dropped when the receive buffer is full.
+  * @param  None
+  * @retval None
+  */
+void UART1_RxISR(void)
+{
+  UART_RxISR(&UART1_Buffer);
 }
+#endif /* UART_BUFFER_SUPPORT */
 
 /**
   * @}
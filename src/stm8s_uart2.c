@@ -33,8 +33,29 @@
   */
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+#if !IS_UART_BUFFER_SIZE_OK(UART2_TX_BUFFER_SIZE)
+ #error "UART2_TX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if !IS_UART_BUFFER_SIZE_OK(UART2_RX_BUFFER_SIZE)
+ #error "UART2_RX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#endif /* UART_BUFFER_SUPPORT */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+static uint8_t UART2_TxBuffer[UART2_TX_BUFFER_SIZE];
+static uint8_t UART2_RxBuffer[UART2_RX_BUFFER_SIZE];
+static UART_Buffer_TypeDef UART2_Buffer =
+{
+  UART2_CORE,
+  UART2_TxBuffer,
+  UART2_RxBuffer,
+  (uint8_t)(UART2_TX_BUFFER_SIZE - 1),
+  (uint8_t)(UART2_RX_BUFFER_SIZE - 1),
+  0, 0, 0, 0
+};
+#endif /* UART_BUFFER_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 /* Public functions ----------------------------------------------------------*/
@@ -52,22 +73,13 @@
 
 void UART2_DeInit(void)
 {
-  /*  Clear the Idle Line Detected bit in the status register by a read
-  to the UART2_SR register followed by a Read to the UART2_DR register */
-  (void) UART2->SR;
-  (void)UART2->DR;
-  
-  UART2->BRR2 = UART2_BRR2_RESET_VALUE;  /*  Set UART2_BRR2 to reset value 0x00 */
-  UART2->BRR1 = UART2_BRR1_RESET_VALUE;  /*  Set UART2_BRR1 to reset value 0x00 */
+  UART_DeInit(UART2_CORE);
   
-  UART2->CR1 = UART2_CR1_RESET_VALUE; /*  Set UART2_CR1 to reset value 0x00  */
-  UART2->CR2 = UART2_CR2_RESET_VALUE; /*  Set UART2_CR2 to reset value 0x00  */
-  UART2->CR3 = UART2_CR3_RESET_VALUE; /*  Set UART2_CR3 to reset value 0x00  */
-  UART2->CR4 = UART2_CR4_RESET_VALUE; /*  Set UART2_CR4 to reset value 0x00  */
   UART2->CR5 = UART2_CR5_RESET_VALUE; /*  Set UART2_CR5 to reset value 0x00  */
   UART2->CR6 = UART2_CR6_RESET_VALUE; /*  Set UART2_CR6 to reset value 0x00  */
 }
 
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 /**
   * @brief  Initializes the UART2 according to the specified parameters.
   * @param  BaudRate: The baudrate.
@@ -84,9 +96,6 @@ void UART2_DeInit(void)
   */
 void UART2_Init(uint32_t BaudRate, UART2_WordLength_TypeDef WordLength, UART2_StopBits_TypeDef StopBits, UART2_Parity_TypeDef Parity, UART2_SyncMode_TypeDef SyncMode, UART2_Mode_TypeDef Mode)
 {
-  uint8_t BRR2_1 = 0, BRR2_2 = 0;
-  uint32_t BaudRate_Mantissa = 0, BaudRate_Mantissa100 = 0;
-  
   /* Check the parameters */
   assert_param(IS_UART2_BAUDRATE_OK(BaudRate));
   assert_param(IS_UART2_WORDLENGTH_OK(WordLength));
@@ -95,81 +104,42 @@ void UART2_Init(uint32_t BaudRate, UART2_WordLength_TypeDef WordLength, UART2_St
   assert_param(IS_UART2_MODE_OK((uint8_t)Mode));
   assert_param(IS_UART2_SYNCMODE_OK((uint8_t)SyncMode));
   
-  /* Clear the word length bit */
-  UART2->CR1 &= (uint8_t)(~UART2_CR1_M);
-  /* Set the word length bit according to UART2_WordLength value */
-  UART2->CR1 |= (uint8_t)WordLength; 
-  
-  /* Clear the STOP bits */
-  UART2->CR3 &= (uint8_t)(~UART2_CR3_STOP);
-  /* Set the STOP bits number according to UART2_StopBits value  */
-  UART2->CR3 |= (uint8_t)StopBits; 
-  
-  /* Clear the Parity Control bit */
-  UART2->CR1 &= (uint8_t)(~(UART2_CR1_PCEN | UART2_CR1_PS  ));
-  /* Set the Parity Control bit to UART2_Parity value */
-  UART2->CR1 |= (uint8_t)Parity;
-  
-  /* Clear the LSB mantissa of UART2DIV  */
-  UART2->BRR1 &= (uint8_t)(~UART2_BRR1_DIVM);
-  /* Clear the MSB mantissa of UART2DIV  */
-  UART2->BRR2 &= (uint8_t)(~UART2_BRR2_DIVM);
-  /* Clear the Fraction bits of UART2DIV */
-  UART2->BRR2 &= (uint8_t)(~UART2_BRR2_DIVF);
-  
-  /* Set the UART2 BaudRates in BRR1 and BRR2 registers according to UART2_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  
-  /* The fraction and MSB mantissa should be loaded in one step in the BRR2 register*/
-  /* Set the fraction of UARTDIV  */
-  BRR2_1 = (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100))
-                                << 4) / 100) & (uint8_t)0x0F); 
-  BRR2_2 = (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0);
-  
-  UART2->BRR2 = (uint8_t)(BRR2_1 | BRR2_2);
-  /* Set the LSB mantissa of UARTDIV  */
-  UART2->BRR1 = (uint8_t)BaudRate_Mantissa;           
-  
-  /* Disable the Transmitter and Receiver before setting the LBCL, CPOL and CPHA bits */
-  UART2->CR2 &= (uint8_t)~(UART2_CR2_TEN | UART2_CR2_REN);
-  /* Clear the Clock Polarity, lock Phase, Last Bit Clock pulse */
-  UART2->CR3 &= (uint8_t)~(UART2_CR3_CPOL | UART2_CR3_CPHA | UART2_CR3_LBCL);
-  /* Set the Clock Polarity, lock Phase, Last Bit Clock pulse */
-  UART2->CR3 |= (uint8_t)((uint8_t)SyncMode & (uint8_t)(UART2_CR3_CPOL | \
-    UART2_CR3_CPHA | UART2_CR3_LBCL));
+  UART_Init(UART2_CORE, BaudRate, (uint8_t)WordLength, (uint8_t)StopBits,
+            (uint8_t)Parity, (uint8_t)SyncMode, (uint8_t)Mode);
+}
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+
+/**
+  * @brief  Initializes the UART2 with precomputed baud rate registers.
+  * @note   This function does not use CLK_GetClockFreq() nor any 32-bit
+  *         division: the register values are given by UART_BRR1_FROM() and
+  *         UART_BRR2_FROM(), or by UART2_BRR1_VALUE and UART2_BRR2_VALUE.
+  * @param  BRR1: BRR1 register value.
+  * @param  BRR2: BRR2 register value.
+  * @param  WordLength : This parameter can be any of the 
+  *         @ref UART2_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART2_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART2_Parity_TypeDef enumeration.
+  * @param  SyncMode: This parameter can be any of the 
+  *         @ref UART2_SyncMode_TypeDef values.
+  * @param  Mode: This parameter can be any of the @ref UART2_Mode_TypeDef values
+  * @retval None
+  */
+void UART2_InitBRR(uint8_t BRR1, uint8_t BRR2, UART2_WordLength_TypeDef WordLength, 
+                   UART2_StopBits_TypeDef StopBits, UART2_Parity_TypeDef Parity, 
+                   UART2_SyncMode_TypeDef SyncMode, UART2_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART2_WORDLENGTH_OK(WordLength));
+  assert_param(IS_UART2_STOPBITS_OK(StopBits));
+  assert_param(IS_UART2_PARITY_OK(Parity));
+  assert_param(IS_UART2_MODE_OK((uint8_t)Mode));
+  assert_param(IS_UART2_SYNCMODE_OK((uint8_t)SyncMode));
   
-  if ((uint8_t)(Mode & UART2_MODE_TX_ENABLE))
-  {
-    /* Set the Transmitter Enable bit */
-    UART2->CR2 |= (uint8_t)UART2_CR2_TEN;
-  }
-  else
-  {
-    /* Clear the Transmitter Disable bit */
-    UART2->CR2 &= (uint8_t)(~UART2_CR2_TEN);
-  }
-  if ((uint8_t)(Mode & UART2_MODE_RX_ENABLE))
-  {
-    /* Set the Receiver Enable bit */
-    UART2->CR2 |= (uint8_t)UART2_CR2_REN;
-  }
-  else
-  {
-    /* Clear the Receiver Disable bit */
-    UART2->CR2 &= (uint8_t)(~UART2_CR2_REN);
-  }
-  /* Set the Clock Enable bit, lock Polarity, lock Phase and Last Bit Clock 
-  pulse bits according to UART2_Mode value */
-  if ((uint8_t)(SyncMode & UART2_SYNCMODE_CLOCK_DISABLE))
-  {
-    /* Clear the Clock Enable bit */
-    UART2->CR3 &= (uint8_t)(~UART2_CR3_CKEN); 
-  }
-  else
-  {
-    UART2->CR3 |= (uint8_t)((uint8_t)SyncMode & UART2_CR3_CKEN);
-  }
+  UART_InitBRR(UART2_CORE, BRR1, BRR2, (uint8_t)WordLength, (uint8_t)StopBits,
+               (uint8_t)Parity, (uint8_t)SyncMode, (uint8_t)Mode);
 }
 
 /**
@@ -180,16 +150,7 @@ void UART2_Init(uint32_t BaudRate, UART2_WordLength_TypeDef WordLength, UART2_St
   */
 void UART2_Cmd(FunctionalState NewState)
 {
-  if (NewState != DISABLE)
-  {
-    /* UART2 Enable */
-    UART2->CR1 &= (uint8_t)(~UART2_CR1_UARTD);
-  }
-  else
-  {
-    /* UART2 Disable */
-    UART2->CR1 |= UART2_CR1_UARTD; 
-  }
+  UART_Cmd(UART2_CORE, NewState);
 }
 
 /**
@@ -209,60 +170,14 @@ void UART2_Cmd(FunctionalState NewState)
   */
 void UART2_ITConfig(UART2_IT_TypeDef UART2_IT, FunctionalState NewState)
 {
-  uint8_t uartreg = 0, itpos = 0x00;
-  
   /* Check the parameters */
   assert_param(IS_UART2_CONFIG_IT_OK(UART2_IT));
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  /* Get the UART2 register index */
-  uartreg = (uint8_t)((uint16_t)UART2_IT >> 0x08);
-  
-  /* Get the UART2 IT index */
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART2_IT & (uint8_t)0x0F));
-  
-  if (NewState != DISABLE)
-  {
-    /* Enable the Interrupt bits according to UART2_IT mask */
-    if (uartreg == 0x01)
-    {
-      UART2->CR1 |= itpos;
-    }
-    else if (uartreg == 0x02)
-    {
-      UART2->CR2 |= itpos;
-    }
-    else if (uartreg == 0x03)
-    {
-      UART2->CR4 |= itpos;
-    }
-    else
-    {
-      UART2->CR6 |= itpos;
-    }
-  }
-  else
-  {
-    /* Disable the interrupt bits according to UART2_IT mask */
-    if (uartreg == 0x01)
-    {
-      UART2->CR1 &= (uint8_t)(~itpos);
-    }
-    else if (uartreg == 0x02)
-    {
-      UART2->CR2 &= (uint8_t)(~itpos);
-    }
-    else if (uartreg == 0x03)
-    {
-      UART2->CR4 &= (uint8_t)(~itpos);
-    }
-    else
-    {
-      UART2->CR6 &= (uint8_t)(~itpos);
-    }
-  }
+  UART_ITConfig(UART2_CORE, (uint16_t)UART2_IT, NewState);
 }
 
+#if defined (UART_IRDA_SUPPORT)
 /**
   * @brief  Configures the UART2s IrDA interface.
   * @param  UART2_IrDAMode specifies the IrDA mode.
@@ -273,14 +188,7 @@ void UART2_IrDAConfig(UART2_IrDAMode_TypeDef UART2_IrDAMode)
 {
   assert_param(IS_UART2_IRDAMODE_OK(UART2_IrDAMode));
   
-  if (UART2_IrDAMode != UART2_IRDAMODE_NORMAL)
-  {
-    UART2->CR5 |= UART2_CR5_IRLP;
-  }
-  else
-  {
-    UART2->CR5 &= ((uint8_t)~UART2_CR5_IRLP);
-  }
+  UART_IrDAConfig(UART2_CORE, (uint8_t)UART2_IrDAMode);
 }
 
 /**
@@ -294,18 +202,11 @@ void UART2_IrDACmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the IrDA mode by setting the IREN bit in the CR3 register */
-    UART2->CR5 |= UART2_CR5_IREN;
-  }
-  else
-  {
-    /* Disable the IrDA mode by clearing the IREN bit in the CR3 register */
-    UART2->CR5 &= ((uint8_t)~UART2_CR5_IREN);
-  }
+  UART_IrDACmd(UART2_CORE, NewState);
 }
+#endif /* UART_IRDA_SUPPORT */
 
+#if defined (UART_LIN_SUPPORT)
 /**
   * @brief  Sets the UART2 LIN Break detection length.
   * @param  UART2_LINBreakDetectionLength specifies the LIN break detection length.
@@ -318,14 +219,7 @@ void UART2_LINBreakDetectionConfig(UART2_LINBreakDetectionLength_TypeDef UART2_L
   /* Check parameters */    
   assert_param(IS_UART2_LINBREAKDETECTIONLENGTH_OK(UART2_LINBreakDetectionLength));
   
-  if (UART2_LINBreakDetectionLength != UART2_LINBREAKDETECTIONLENGTH_10BITS)
-  {
-    UART2->CR4 |= UART2_CR4_LBDL;
-  }
-  else
-  {
-    UART2->CR4 &= ((uint8_t)~UART2_CR4_LBDL);
-  }
+  UART_LINBreakDetectionConfig(UART2_CORE, (uint8_t)UART2_LINBreakDetectionLength);
 }
 
 /**
@@ -347,32 +241,7 @@ void UART2_LINConfig(UART2_LinMode_TypeDef UART2_Mode,
   assert_param(IS_UART2_AUTOSYNC_OK(UART2_Autosync));
   assert_param(IS_UART2_DIVUP_OK(UART2_DivUp));
   
-  if (UART2_Mode != UART2_LIN_MODE_MASTER)
-  {
-    UART2->CR6 |=  UART2_CR6_LSLV;
-  }
-  else
-  {
-    UART2->CR6 &= ((uint8_t)~UART2_CR6_LSLV);
-  }
-  
-  if (UART2_Autosync != UART2_LIN_AUTOSYNC_DISABLE)
-  {
-    UART2->CR6 |=  UART2_CR6_LASE ;
-  }
-  else
-  {
-    UART2->CR6 &= ((uint8_t)~ UART2_CR6_LASE );
-  }
-  
-  if (UART2_DivUp != UART2_LIN_DIVUP_LBRR1)
-  {
-    UART2->CR6 |=  UART2_CR6_LDUM;
-  }
-  else
-  {
-    UART2->CR6 &= ((uint8_t)~ UART2_CR6_LDUM);
-  }
+  UART_LINConfig(UART2_CORE, (uint8_t)UART2_Mode, (uint8_t)UART2_Autosync, (uint8_t)UART2_DivUp);
 }
 
 /**
@@ -385,18 +254,11 @@ void UART2_LINCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the LIN mode by setting the LINE bit in the CR2 register */
-    UART2->CR3 |= UART2_CR3_LINEN;
-  }
-  else
-  {
-    /* Disable the LIN mode by clearing the LINE bit in the CR2 register */
-    UART2->CR3 &= ((uint8_t)~UART2_CR3_LINEN);
-  }
+  UART_LINCmd(UART2_CORE, NewState);
 }
+#endif /* UART_LIN_SUPPORT */
 
+#if defined (UART_SMARTCARD_SUPPORT)
 /**
   * @brief  Enables or disables the UART2 Smart Card mode.
   * @param  NewState: new state of the Smart Card mode.
@@ -408,16 +270,7 @@ void UART2_SmartCardCmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the SC mode by setting the SCEN bit in the CR5 register */
-    UART2->CR5 |= UART2_CR5_SCEN;
-  }
-  else
-  {
-    /* Disable the SC mode by clearing the SCEN bit in the CR5 register */
-    UART2->CR5 &= ((uint8_t)(~UART2_CR5_SCEN));
-  }
+  UART_SmartCardCmd(UART2_CORE, NewState);
 }
 
 /**
@@ -431,17 +284,9 @@ void UART2_SmartCardNACKCmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the NACK transmission by setting the NACK bit in the CR5 register */
-    UART2->CR5 |= UART2_CR5_NACK;
-  }
-  else
-  {
-    /* Disable the NACK transmission by clearing the NACK bit in the CR5 register */
-    UART2->CR5 &= ((uint8_t)~(UART2_CR5_NACK));
-  }
+  UART_SmartCardNACKCmd(UART2_CORE, NewState);
 }
+#endif /* UART_SMARTCARD_SUPPORT */
 
 /**
   * @brief  Selects the UART2 WakeUp method.
@@ -453,8 +298,7 @@ void UART2_WakeUpConfig(UART2_WakeUp_TypeDef UART2_WakeUp)
 {
   assert_param(IS_UART2_WAKEUP_OK(UART2_WakeUp));
   
-  UART2->CR1 &= ((uint8_t)~UART2_CR1_WAKE);
-  UART2->CR1 |= (uint8_t)UART2_WakeUp;
+  UART_WakeUpConfig(UART2_CORE, (uint8_t)UART2_WakeUp);
 }
 
 /**
@@ -467,16 +311,7 @@ void UART2_ReceiverWakeUpCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the mute mode UART2 by setting the RWU bit in the CR2 register */
-    UART2->CR2 |= UART2_CR2_RWU;
-  }
-  else
-  {
-    /* Disable the mute mode UART2 by clearing the RWU bit in the CR1 register */
-    UART2->CR2 &= ((uint8_t)~UART2_CR2_RWU);
-  }
+  UART_ReceiverWakeUpCmd(UART2_CORE, NewState);
 }
 
 /**
@@ -496,11 +331,7 @@ uint8_t UART2_ReceiveData8(void)
   */
 uint16_t UART2_ReceiveData9(void)
 {
-  uint16_t temp = 0;
-  
-  temp = ((uint16_t)(((uint16_t)((uint16_t)UART2->CR1 & (uint16_t)UART2_CR1_R8)) << 1));
-  
-  return (uint16_t)((((uint16_t)UART2->DR) | temp) & ((uint16_t)0x01FF));
+  return UART_ReceiveData9(UART2_CORE);
 }
 
 /**
@@ -521,14 +352,7 @@ void UART2_SendData8(uint8_t Data)
   */
 void UART2_SendData9(uint16_t Data)
 {
-  /* Clear the transmit data bit 8 */
-  UART2->CR1 &= ((uint8_t)~UART2_CR1_T8);                  
-  
-  /* Write the transmit data bit [8] */
-  UART2->CR1 |= (uint8_t)(((uint8_t)(Data >> 2)) & UART2_CR1_T8); 
-  
-  /* Write the transmit data bit [0:7] */
-  UART2->DR   = (uint8_t)(Data);                    
+  UART_SendData9(UART2_CORE, Data);
 }
 
 /**
@@ -551,12 +375,10 @@ void UART2_SetAddress(uint8_t UART2_Address)
   /*assert_param for x UART2_Address*/
   assert_param(IS_UART2_ADDRESS_OK(UART2_Address));
   
-  /* Clear the UART2 address */
-  UART2->CR4 &= ((uint8_t)~UART2_CR4_ADD);
-  /* Set the UART2 address node */
-  UART2->CR4 |= UART2_Address;
+  UART_SetAddress(UART2_CORE, UART2_Address);
 }
 
+#if defined (UART_SMARTCARD_SUPPORT)
 /**
   * @brief  Sets the specified UART2 guard time.
   * @note   SmartCard Mode should be Enabled  
@@ -568,7 +390,9 @@ void UART2_SetGuardTime(uint8_t UART2_GuardTime)
   /* Set the UART2 guard time */
   UART2->GTR = UART2_GuardTime;
 }
+#endif /* UART_SMARTCARD_SUPPORT */
 
+#if defined (UART_SMARTCARD_SUPPORT) || defined (UART_IRDA_SUPPORT)
 /**
   * @brief  Sets the system clock prescaler.
   * @note   IrDA Low Power mode or smartcard mode should be enabled
@@ -596,6 +420,7 @@ void UART2_SetPrescaler(uint8_t UART2_Prescaler)
   /* Load the UART2 prescaler value*/
   UART2->PSCR = UART2_Prescaler;
 }
+#endif /* UART_SMARTCARD_SUPPORT || UART_IRDA_SUPPORT */
 
 /**
   * @brief  Checks whether the specified UART2 flag is set or not.
@@ -605,67 +430,11 @@ void UART2_SetPrescaler(uint8_t UART2_Prescaler)
   */
 FlagStatus UART2_GetFlagStatus(UART2_Flag_TypeDef UART2_FLAG)
 {
-  FlagStatus status = RESET;
-  
   /* Check parameters */
   assert_param(IS_UART2_FLAG_OK(UART2_FLAG));
   
-  /* Check the status of the specified UART2 flag*/
-  if (UART2_FLAG == UART2_FLAG_LBDF)
-  {
-    if ((UART2->CR4 & (uint8_t)UART2_FLAG) != (uint8_t)0x00)
-    {
-      /* UART2_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART2_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if (UART2_FLAG == UART2_FLAG_SBK)
-  {
-    if ((UART2->CR2 & (uint8_t)UART2_FLAG) != (uint8_t)0x00)
-    {
-      /* UART2_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART2_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if ((UART2_FLAG == UART2_FLAG_LHDF) || (UART2_FLAG == UART2_FLAG_LSF))
-  {
-    if ((UART2->CR6 & (uint8_t)UART2_FLAG) != (uint8_t)0x00)
-    {
-      /* UART2_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART2_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else
-  {
-    if ((UART2->SR & (uint8_t)UART2_FLAG) != (uint8_t)0x00)
-    {
-      /* UART2_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART2_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  
   /* Return the UART2_FLAG status*/
-  return  status;
+  return UART_GetFlagStatus(UART2_CORE, (uint16_t)UART2_FLAG);
 }
 
 /**
@@ -700,26 +469,7 @@ void UART2_ClearFlag(UART2_Flag_TypeDef UART2_FLAG)
 {
   assert_param(IS_UART2_CLEAR_FLAG_OK(UART2_FLAG));
   
-  /*  Clear the Receive Register Not Empty flag */
-  if (UART2_FLAG == UART2_FLAG_RXNE)
-  {
-    UART2->SR = (uint8_t)~(UART2_SR_RXNE);
-  }
-  /*  Clear the LIN Break Detection flag */
-  else if (UART2_FLAG == UART2_FLAG_LBDF)
-  {
-    UART2->CR4 &= (uint8_t)(~UART2_CR4_LBDF);
-  }
-  /*  Clear the LIN Header Detection Flag */
-  else if (UART2_FLAG == UART2_FLAG_LHDF)
-  {
-    UART2->CR6 &= (uint8_t)(~UART2_CR6_LHDF);
-  }
-  /*  Clear the LIN Synch Field flag */
-  else
-  {
-    UART2->CR6 &= (uint8_t)(~UART2_CR6_LSF);
-  }
+  UART_ClearFlag(UART2_CORE, (uint16_t)UART2_FLAG);
 }
 
 /**
@@ -737,90 +487,11 @@ void UART2_ClearFlag(UART2_Flag_TypeDef UART2_FLAG)
   */
 ITStatus UART2_GetITStatus(UART2_IT_TypeDef UART2_IT)
 {
-  ITStatus pendingbitstatus = RESET;
-  uint8_t itpos = 0;
-  uint8_t itmask1 = 0;
-  uint8_t itmask2 = 0;
-  uint8_t enablestatus = 0;
-  
   /* Check parameters */
   assert_param(IS_UART2_GET_IT_OK(UART2_IT));
   
-  /* Get the UART2 IT index*/
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART2_IT & (uint8_t)0x0F));
-  /* Get the UART2 IT index*/
-  itmask1 = (uint8_t)((uint8_t)UART2_IT >> (uint8_t)4);
-  /* Set the IT mask*/
-  itmask2 = (uint8_t)((uint8_t)1 << itmask1);
-  
-  /* Check the status of the specified UART2 pending bit*/
-  if (UART2_IT == UART2_IT_PE)
-  {
-    /* Get the UART2_ITPENDINGBIT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART2->CR1 & itmask2);
-    /* Check the status of the specified UART2 interrupt*/
-    
-    if (((UART2->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else if (UART2_IT == UART2_IT_LBDF)
-  {
-    /* Get the UART2_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART2->CR4 & itmask2);
-    /* Check the status of the specified UART2 interrupt*/
-    if (((UART2->CR4 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else if (UART2_IT == UART2_IT_LHDF)
-  {
-    /* Get the UART2_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART2->CR6 & itmask2);
-    /* Check the status of the specified UART2 interrupt*/
-    if (((UART2->CR6 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else
-  {
-    /* Get the UART2_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART2->CR2 & itmask2);
-    /* Check the status of the specified UART2 interrupt*/
-    if (((UART2->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
   /* Return the UART2_IT status*/
-  return  pendingbitstatus;
+  return UART_GetITStatus(UART2_CORE, (uint16_t)UART2_IT);
 }
 
 /**
@@ -853,22 +524,99 @@ void UART2_ClearITPendingBit(UART2_IT_TypeDef UART2_IT)
 {
   assert_param(IS_UART2_CLEAR_IT_OK(UART2_IT));
   
-  /*  Clear the Receive Register Not Empty pending bit */
-  if (UART2_IT == UART2_IT_RXNE)
-  {
-    UART2->SR = (uint8_t)~(UART2_SR_RXNE);
-  }
-  /*  Clear the LIN Break Detection pending bit */
-  else if (UART2_IT == UART2_IT_LBDF)
-  {
-    UART2->CR4 &= (uint8_t)~(UART2_CR4_LBDF);
-  }
-  /*  Clear the LIN Header Detection pending bit */
-  else
-  {
-    UART2->CR6 &= (uint8_t)(~UART2_CR6_LHDF);
-  }
+  UART_ClearITPendingBit(UART2_CORE, (uint16_t)UART2_IT);
+}
+
+#if defined (UART_BUFFER_SUPPORT)
+/**
+  * @brief  Enables or disables the interrupt driven UART2 buffers.
+  * @note   Both ring buffers are flushed. When enabled, the receiver interrupt
+  *         is turned on so that incoming bytes are stored by UART2_RxISR();
+  *         the transmitter interrupt is turned on by UART2_Write() on demand.
+  * @note   UART2_TxISR() and UART2_RxISR() must be called from the UART2 TX
+  *         and RX interrupt routines and the buffers only carry 8-bit data.
+  * @note   The buffers are handled by the UART core, see UART_BufferCmd().
+  * @param  NewState: new state of the UART2 buffers.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART2_BufferCmd(FunctionalState NewState)
+{
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  
+  UART_BufferCmd(&UART2_Buffer, NewState);
+}
+
+/**
+  * @brief  Queues data for interrupt driven transmission through UART2.
+  * @note   This function never waits: only the bytes that fit in the free
+  *         space of the transmit buffer are queued.
+  * @param  Buffer: pointer to the data to transmit.
+  * @param  Length: number of bytes to transmit.
+  * @retval The number of bytes actually queued.
+  */
+uint8_t UART2_Write(const uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Write(&UART2_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Fetches the data received by UART2 from the receive buffer.
+  * @note   This function never waits: only the bytes already received
+  *         are returned.
+  * @param  Buffer: pointer to the destination buffer.
+  * @param  Length: maximum number of bytes to read.
+  * @retval The number of bytes actually read.
+  */
+uint8_t UART2_Read(uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Read(&UART2_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Returns the number of received bytes waiting in the receive buffer.
+  * @param  None
+  * @retval Number of bytes available to UART2_Read().
+  */
+uint8_t UART2_GetRxCount(void)
+{
+  return UART_GetRxCount(&UART2_Buffer);
+}
+
+/**
+  * @brief  Returns the free space left in the transmit buffer.
+  * @param  None
+  * @retval Number of bytes UART2_Write() can accept without truncation.
+  */
+uint8_t UART2_GetTxFree(void)
+{
+  return UART_GetTxFree(&UART2_Buffer);
+}
+
+/**
+  * @brief  Feeds the UART2 transmitter from the transmit buffer.
+  * @note   To be called from the UART2 TX interrupt routine. The transmitter
+  *         interrupt is disabled as soon as the last byte is loaded.
+  * @param  None
+  * @retval None
+  */
+void UART2_TxISR(void)
+{
+  UART_TxISR(&UART2_Buffer);
+}
+
+/**
+  * @brief  Stores the byte received by UART2 into the receive buffer.
+  * @note   To be called from the UART2 RX interrupt routine. The byte is
+  *         dropped when the receive buffer is full.
+  * @param  None
+  * @retval None
+  */
+void UART2_RxISR(void)
+{
+  UART_RxISR(&UART2_Buffer);
 }
+#endif /* UART_BUFFER_SUPPORT */
 
 /**
   * @}
@@ -33,8 +33,29 @@
   */
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+#if !IS_UART_BUFFER_SIZE_OK(UART3_TX_BUFFER_SIZE)
+ #error "UART3_TX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if !IS_UART_BUFFER_SIZE_OK(UART3_RX_BUFFER_SIZE)
+ #error "UART3_RX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#endif /* UART_BUFFER_SUPPORT */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+static uint8_t UART3_TxBuffer[UART3_TX_BUFFER_SIZE];
+static uint8_t UART3_RxBuffer[UART3_RX_BUFFER_SIZE];
+static UART_Buffer_TypeDef UART3_Buffer =
+{
+  UART3_CORE,
+  UART3_TxBuffer,
+  UART3_RxBuffer,
+  (uint8_t)(UART3_TX_BUFFER_SIZE - 1),
+  (uint8_t)(UART3_RX_BUFFER_SIZE - 1),
+  0, 0, 0, 0
+};
+#endif /* UART_BUFFER_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 
 /* Private functions ---------------------------------------------------------*/
@@ -53,21 +74,12 @@
 
 void UART3_DeInit(void)
 {
-  /* Clear the Idle Line Detected bit in the status rerister by a read
-  to the UART3_SR register followed by a Read to the UART3_DR register */
-  (void) UART3->SR;
-  (void) UART3->DR;
-  
-  UART3->BRR2 = UART3_BRR2_RESET_VALUE; /*Set UART3_BRR2 to reset value 0x00 */
-  UART3->BRR1 = UART3_BRR1_RESET_VALUE; /*Set UART3_BRR1 to reset value 0x00 */
+  UART_DeInit(UART3_CORE);
   
-  UART3->CR1 = UART3_CR1_RESET_VALUE;  /*Set UART3_CR1 to reset value 0x00  */
-  UART3->CR2 = UART3_CR2_RESET_VALUE;  /*Set UART3_CR2 to reset value 0x00  */
-  UART3->CR3 = UART3_CR3_RESET_VALUE;  /*Set UART3_CR3 to reset value 0x00  */
-  UART3->CR4 = UART3_CR4_RESET_VALUE;  /*Set UART3_CR4 to reset value 0x00  */
   UART3->CR6 = UART3_CR6_RESET_VALUE;  /*Set UART3_CR6 to reset value 0x00  */
 }
 
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 /**
   * @brief  Initializes the UART3 according to the specified parameters.
   * @param  BaudRate: The baudrate.
@@ -84,9 +96,6 @@ void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength,
                 UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
                 UART3_Mode_TypeDef Mode)
 {
-  uint8_t BRR2_1 = 0, BRR2_2 = 0;
-  uint32_t BaudRate_Mantissa = 0, BaudRate_Mantissa100 = 0;
-  
   /* Check the parameters */
   assert_param(IS_UART3_WORDLENGTH_OK(WordLength));
   assert_param(IS_UART3_STOPBITS_OK(StopBits));
@@ -94,61 +103,39 @@ void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength,
   assert_param(IS_UART3_BAUDRATE_OK(BaudRate));
   assert_param(IS_UART3_MODE_OK((uint8_t)Mode));
   
-  /* Clear the word length bit */
-  UART3->CR1 &= (uint8_t)(~UART3_CR1_M);     
-  /* Set the word length bit according to UART3_WordLength value */
-  UART3->CR1 |= (uint8_t)WordLength; 
-  
-  /* Clear the STOP bits */
-  UART3->CR3 &= (uint8_t)(~UART3_CR3_STOP);  
-  /* Set the STOP bits number according to UART3_StopBits value  */
-  UART3->CR3 |= (uint8_t)StopBits;  
-  
-  /* Clear the Parity Control bit */
-  UART3->CR1 &= (uint8_t)(~(UART3_CR1_PCEN | UART3_CR1_PS));  
-  /* Set the Parity Control bit to UART3_Parity value */
-  UART3->CR1 |= (uint8_t)Parity;     
-  
-  /* Clear the LSB mantissa of UART3DIV  */
-  UART3->BRR1 &= (uint8_t)(~UART3_BRR1_DIVM);  
-  /* Clear the MSB mantissa of UART3DIV  */
-  UART3->BRR2 &= (uint8_t)(~UART3_BRR2_DIVM);  
-  /* Clear the Fraction bits of UART3DIV */
-  UART3->BRR2 &= (uint8_t)(~UART3_BRR2_DIVF);  
-  
-  /* Set the UART3 BaudRates in BRR1 and BRR2 registers according to UART3_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  /* The fraction and MSB mantissa should be loaded in one step in the BRR2 register */
-  /* Set the fraction of UART3DIV  */
-  BRR2_1 = (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100))
-                                << 4) / 100) & (uint8_t)0x0F); 
-  BRR2_2 = (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0);
-  
-  UART3->BRR2 = (uint8_t)(BRR2_1 | BRR2_2);
-  /* Set the LSB mantissa of UART3DIV  */
-  UART3->BRR1 = (uint8_t)BaudRate_Mantissa;           
+  UART_Init(UART3_CORE, BaudRate, (uint8_t)WordLength, (uint8_t)StopBits,
+            (uint8_t)Parity, UART_SYNCMODE_NONE, (uint8_t)Mode);
+}
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+
+/**
+  * @brief  Initializes the UART3 with precomputed baud rate registers.
+  * @note   This function does not use CLK_GetClockFreq() nor any 32-bit
+  *         division: the register values are given by UART_BRR1_FROM() and
+  *         UART_BRR2_FROM(), or by UART3_BRR1_VALUE and UART3_BRR2_VALUE.
+  * @param  BRR1: BRR1 register value.
+  * @param  BRR2: BRR2 register value.
+  * @param  WordLength : This parameter can be any of the 
+  *         @ref UART3_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART3_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART3_Parity_TypeDef enumeration.
+  * @param  Mode: This parameter can be any of the @ref UART3_Mode_TypeDef values
+  * @retval None
+  */
+void UART3_InitBRR(uint8_t BRR1, uint8_t BRR2, UART3_WordLength_TypeDef WordLength, 
+                   UART3_StopBits_TypeDef StopBits, UART3_Parity_TypeDef Parity, 
+                   UART3_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART3_WORDLENGTH_OK(WordLength));
+  assert_param(IS_UART3_STOPBITS_OK(StopBits));
+  assert_param(IS_UART3_PARITY_OK(Parity));
+  assert_param(IS_UART3_MODE_OK((uint8_t)Mode));
   
-  if ((uint8_t)(Mode & UART3_MODE_TX_ENABLE))
-  {
-    /* Set the Transmitter Enable bit */
-    UART3->CR2 |= UART3_CR2_TEN;  
-  }
-  else
-  {
-    /* Clear the Transmitter Disable bit */
-    UART3->CR2 &= (uint8_t)(~UART3_CR2_TEN);  
-  }
-  if ((uint8_t)(Mode & UART3_MODE_RX_ENABLE))
-  {
-    /* Set the Receiver Enable bit */
-    UART3->CR2 |= UART3_CR2_REN;  
-  }
-  else
-  {
-    /* Clear the Receiver Disable bit */
-    UART3->CR2 &= (uint8_t)(~UART3_CR2_REN);  
-  }
+  UART_InitBRR(UART3_CORE, BRR1, BRR2, (uint8_t)WordLength, (uint8_t)StopBits,
+               (uint8_t)Parity, UART_SYNCMODE_NONE, (uint8_t)Mode);
 }
 
 /**
@@ -159,16 +146,7 @@ void UART3_Init(uint32_t BaudRate, UART3_WordLength_TypeDef WordLength,
   */
 void UART3_Cmd(FunctionalState NewState)
 {
-  if (NewState != DISABLE)
-  {
-    /* UART3 Enable */
-    UART3->CR1 &= (uint8_t)(~UART3_CR1_UARTD); 
-  }
-  else
-  {
-    /* UART3 Disable */
-    UART3->CR1 |= UART3_CR1_UARTD;  
-  }
+  UART_Cmd(UART3_CORE, NewState);
 }
 
 /**
@@ -188,60 +166,14 @@ void UART3_Cmd(FunctionalState NewState)
   */
 void UART3_ITConfig(UART3_IT_TypeDef UART3_IT, FunctionalState NewState)
 {
-  uint8_t uartreg = 0, itpos = 0x00;
-  
   /* Check the parameters */
   assert_param(IS_UART3_CONFIG_IT_OK(UART3_IT));
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  /* Get the UART3 register index */
-  uartreg = (uint8_t)((uint16_t)UART3_IT >> 0x08);
-  
-  /* Get the UART3 IT index */
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART3_IT & (uint8_t)0x0F));
-  
-  if (NewState != DISABLE)
-  {
-    /* Enable the Interrupt bits according to UART3_IT mask */
-    if (uartreg == 0x01)
-    {
-      UART3->CR1 |= itpos;
-    }
-    else if (uartreg == 0x02)
-    {
-      UART3->CR2 |= itpos;
-    }
-    else if (uartreg == 0x03)
-    {
-      UART3->CR4 |= itpos;
-    }
-    else
-    {
-      UART3->CR6 |= itpos;
-    }
-  }
-  else
-  {
-    /* Disable the interrupt bits according to UART3_IT mask */
-    if (uartreg == 0x01)
-    {
-      UART3->CR1 &= (uint8_t)(~itpos);
-    }
-    else if (uartreg == 0x02)
-    {
-      UART3->CR2 &= (uint8_t)(~itpos);
-    }
-    else if (uartreg == 0x03)
-    {
-      UART3->CR4 &= (uint8_t)(~itpos);
-    }
-    else
-    {
-      UART3->CR6 &= (uint8_t)(~itpos);
-    }
-  }
+  UART_ITConfig(UART3_CORE, (uint16_t)UART3_IT, NewState);
 }
 
+#if defined (UART_LIN_SUPPORT)
 /**
   * @brief  Sets the UART3 LIN Break detection length.
   * @param  UART3_LINBreakDetectionLength specifies the LIN break detection length.
@@ -254,14 +186,7 @@ void UART3_LINBreakDetectionConfig(UART3_LINBreakDetectionLength_TypeDef UART3_L
   /* Check the parameters */
   assert_param(IS_UART3_LINBREAKDETECTIONLENGTH_OK(UART3_LINBreakDetectionLength));
   
-  if (UART3_LINBreakDetectionLength != UART3_LINBREAKDETECTIONLENGTH_10BITS)
-  {
-    UART3->CR4 |= UART3_CR4_LBDL;
-  }
-  else
-  {
-    UART3->CR4 &= ((uint8_t)~UART3_CR4_LBDL);
-  }
+  UART_LINBreakDetectionConfig(UART3_CORE, (uint8_t)UART3_LINBreakDetectionLength);
 }
 
 /**
@@ -283,32 +208,7 @@ void UART3_LINConfig(UART3_LinMode_TypeDef UART3_Mode,
   assert_param(IS_UART3_AUTOSYNC_OK(UART3_Autosync));
   assert_param(IS_UART3_DIVUP_OK(UART3_DivUp));
   
-  if (UART3_Mode != UART3_LIN_MODE_MASTER)
-  {
-    UART3->CR6 |=  UART3_CR6_LSLV;
-  }
-  else
-  {
-    UART3->CR6 &= ((uint8_t)~UART3_CR6_LSLV);
-  }
-  
-  if (UART3_Autosync != UART3_LIN_AUTOSYNC_DISABLE)
-  {
-    UART3->CR6 |=  UART3_CR6_LASE ;
-  }
-  else
-  {
-    UART3->CR6 &= ((uint8_t)~ UART3_CR6_LASE );
-  }
-  
-  if (UART3_DivUp != UART3_LIN_DIVUP_LBRR1)
-  {
-    UART3->CR6 |=  UART3_CR6_LDUM;
-  }
-  else
-  {
-    UART3->CR6 &= ((uint8_t)~ UART3_CR6_LDUM);
-  }
+  UART_LINConfig(UART3_CORE, (uint8_t)UART3_Mode, (uint8_t)UART3_Autosync, (uint8_t)UART3_DivUp);
 }
 
 /**
@@ -322,17 +222,9 @@ void UART3_LINCmd(FunctionalState NewState)
   /* Check the parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the LIN mode by setting the LINE bit in the CR2 register */
-    UART3->CR3 |= UART3_CR3_LINEN;
-  }
-  else
-  {
-    /* Disable the LIN mode by clearing the LINE bit in the CR2 register */
-    UART3->CR3 &= ((uint8_t)~UART3_CR3_LINEN);
-  }
+  UART_LINCmd(UART3_CORE, NewState);
 }
+#endif /* UART_LIN_SUPPORT */
 
 /**
   * @brief  Selects the UART3 WakeUp method.
@@ -345,8 +237,7 @@ void UART3_WakeUpConfig(UART3_WakeUp_TypeDef UART3_WakeUp)
   /* Check the parameters */
   assert_param(IS_UART3_WAKEUP_OK(UART3_WakeUp));
   
-  UART3->CR1 &= ((uint8_t)~UART3_CR1_WAKE);
-  UART3->CR1 |= (uint8_t)UART3_WakeUp;
+  UART_WakeUpConfig(UART3_CORE, (uint8_t)UART3_WakeUp);
 }
 
 /**
@@ -360,16 +251,7 @@ void UART3_ReceiverWakeUpCmd(FunctionalState NewState)
   /* Check the parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    /* Enable the mute mode UART3 by setting the RWU bit in the CR2 register */
-    UART3->CR2 |= UART3_CR2_RWU;
-  }
-  else
-  {
-    /* Disable the mute mode UART3 by clearing the RWU bit in the CR1 register */
-    UART3->CR2 &= ((uint8_t)~UART3_CR2_RWU);
-  }
+  UART_ReceiverWakeUpCmd(UART3_CORE, NewState);
 }
 
 /**
@@ -389,10 +271,7 @@ uint8_t UART3_ReceiveData8(void)
   */
 uint16_t UART3_ReceiveData9(void)
 {
-  uint16_t temp = 0;
-  
-  temp = (uint16_t)(((uint16_t)((uint16_t)UART3->CR1 & (uint16_t)UART3_CR1_R8)) << 1);
-  return (uint16_t)((((uint16_t)UART3->DR) | temp) & ((uint16_t)0x01FF));
+  return UART_ReceiveData9(UART3_CORE);
 }
 
 /**
@@ -413,14 +292,7 @@ void UART3_SendData8(uint8_t Data)
   */
 void UART3_SendData9(uint16_t Data)
 {
-  /* Clear the transmit data bit 8 */
-  UART3->CR1 &= ((uint8_t)~UART3_CR1_T8);                  
-  
-  /* Write the transmit data bit [8] */
-  UART3->CR1 |= (uint8_t)(((uint8_t)(Data >> 2)) & UART3_CR1_T8); 
-  
-  /* Write the transmit data bit [0:7] */
-  UART3->DR   = (uint8_t)(Data);                    
+  UART_SendData9(UART3_CORE, Data);
 }
 
 /**
@@ -443,10 +315,7 @@ void UART3_SetAddress(uint8_t UART3_Address)
   /* Check the parameters */
   assert_param(IS_UART3_ADDRESS_OK(UART3_Address));
   
-  /* Clear the UART3 address */
-  UART3->CR4 &= ((uint8_t)~UART3_CR4_ADD);
-  /* Set the UART3 address node */
-  UART3->CR4 |= UART3_Address;
+  UART_SetAddress(UART3_CORE, UART3_Address);
 }
 
 /**
@@ -457,67 +326,11 @@ void UART3_SetAddress(uint8_t UART3_Address)
   */
 FlagStatus UART3_GetFlagStatus(UART3_Flag_TypeDef UART3_FLAG)
 {
-  FlagStatus status = RESET;
-  
   /* Check parameters */
   assert_param(IS_UART3_FLAG_OK(UART3_FLAG));
   
-  /* Check the status of the specified UART3 flag*/
-  if (UART3_FLAG == UART3_FLAG_LBDF)
-  {
-    if ((UART3->CR4 & (uint8_t)UART3_FLAG) != (uint8_t)0x00)
-    {
-      /* UART3_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART3_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if (UART3_FLAG == UART3_FLAG_SBK)
-  {
-    if ((UART3->CR2 & (uint8_t)UART3_FLAG) != (uint8_t)0x00)
-    {
-      /* UART3_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART3_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if ((UART3_FLAG == UART3_FLAG_LHDF) || (UART3_FLAG == UART3_FLAG_LSF))
-  {
-    if ((UART3->CR6 & (uint8_t)UART3_FLAG) != (uint8_t)0x00)
-    {
-      /* UART3_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART3_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else
-  {
-    if ((UART3->SR & (uint8_t)UART3_FLAG) != (uint8_t)0x00)
-    {
-      /* UART3_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART3_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  
   /* Return the UART3_FLAG status*/
-  return  status;
+  return UART_GetFlagStatus(UART3_CORE, (uint16_t)UART3_FLAG);
 }
 
 /**
@@ -553,26 +366,7 @@ void UART3_ClearFlag(UART3_Flag_TypeDef UART3_FLAG)
   /* Check the parameters */
   assert_param(IS_UART3_CLEAR_FLAG_OK(UART3_FLAG));
   
-  /*Clear the Receive Register Not Empty flag */
-  if (UART3_FLAG == UART3_FLAG_RXNE)
-  {
-    UART3->SR = (uint8_t)~(UART3_SR_RXNE);
-  }
-  /*Clear the LIN Break Detection flag */
-  else if (UART3_FLAG == UART3_FLAG_LBDF)
-  {
-    UART3->CR4 &= (uint8_t)(~UART3_CR4_LBDF);
-  }
-  /*Clear the LIN Header Detection Flag */
-  else if (UART3_FLAG == UART3_FLAG_LHDF)
-  {
-    UART3->CR6 &= (uint8_t)(~UART3_CR6_LHDF);
-  }
-  /*Clear the LIN Synch Field flag */
-  else
-  {
-    UART3->CR6 &= (uint8_t)(~UART3_CR6_LSF);
-  }
+  UART_ClearFlag(UART3_CORE, (uint16_t)UART3_FLAG);
 }
 
 /**
@@ -590,90 +384,11 @@ void UART3_ClearFlag(UART3_Flag_TypeDef UART3_FLAG)
   */
 ITStatus UART3_GetITStatus(UART3_IT_TypeDef UART3_IT)
 {
-  ITStatus pendingbitstatus = RESET;
-  uint8_t itpos = 0;
-  uint8_t itmask1 = 0;
-  uint8_t itmask2 = 0;
-  uint8_t enablestatus = 0;
-  
   /* Check parameters */
   assert_param(IS_UART3_GET_IT_OK(UART3_IT));
   
-  /* Get the UART3 IT index*/
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART3_IT & (uint8_t)0x0F));
-  /* Get the UART3 IT index*/
-  itmask1 = (uint8_t)((uint8_t)UART3_IT >> (uint8_t)4);
-  /* Set the IT mask*/
-  itmask2 = (uint8_t)((uint8_t)1 << itmask1);
-  
-  /* Check the status of the specified UART3 pending bit*/
-  if (UART3_IT == UART3_IT_PE)
-  {
-    /* Get the UART3_ITPENDINGBIT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART3->CR1 & itmask2);
-    /* Check the status of the specified UART3 interrupt*/
-    
-    if (((UART3->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else if (UART3_IT == UART3_IT_LBDF)
-  {
-    /* Get the UART3_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART3->CR4 & itmask2);
-    /* Check the status of the specified UART3 interrupt*/
-    if (((UART3->CR4 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else if (UART3_IT == UART3_IT_LHDF)
-  {
-    /* Get the UART3_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART3->CR6 & itmask2);
-    /* Check the status of the specified UART3 interrupt*/
-    if (((UART3->CR6 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else
-  {
-    /* Get the UART3_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART3->CR2 & itmask2);
-    /* Check the status of the specified UART3 interrupt*/
-    if (((UART3->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
   /* Return the UART3_IT status*/
-  return  pendingbitstatus;
+  return UART_GetITStatus(UART3_CORE, (uint16_t)UART3_IT);
 }
 
 /**
@@ -708,22 +423,99 @@ void UART3_ClearITPendingBit(UART3_IT_TypeDef UART3_IT)
   /* Check the parameters */
   assert_param(IS_UART3_CLEAR_IT_OK(UART3_IT));
   
-  /*Clear the Receive Register Not Empty pending bit */
-  if (UART3_IT == UART3_IT_RXNE)
-  {
-    UART3->SR = (uint8_t)~(UART3_SR_RXNE);
-  }
-  /*Clear the LIN Break Detection pending bit */
-  else if (UART3_IT == UART3_IT_LBDF)
-  {
-    UART3->CR4 &= (uint8_t)~(UART3_CR4_LBDF);
-  }
-  /*Clear the LIN Header Detection pending bit */
-  else
-  {
-    UART3->CR6 &= (uint8_t)(~UART3_CR6_LHDF);
-  }
+  UART_ClearITPendingBit(UART3_CORE, (uint16_t)UART3_IT);
+}
+
+#if defined (UART_BUFFER_SUPPORT)
+/**
+  * @brief  Enables or disables the interrupt driven UART3 buffers.
+  * @note   Both ring buffers are flushed. When enabled, the receiver interrupt
+  *         is turned on so that incoming bytes are stored by UART3_RxISR();
+  *         the transmitter interrupt is turned on by UART3_Write() on demand.
+  * @note   UART3_TxISR() and UART3_RxISR() must be called from the UART3 TX
+  *         and RX interrupt routines and the buffers only carry 8-bit data.
+  * @note   The buffers are handled by the UART core, see UART_BufferCmd().
+  * @param  NewState: new state of the UART3 buffers.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART3_BufferCmd(FunctionalState NewState)
+{
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  
+  UART_BufferCmd(&UART3_Buffer, NewState);
+}
+
+/**
+  * @brief  Queues data for interrupt driven transmission through UART3.
+  * @note   This function never waits: only the bytes that fit in the free
+  *         space of the transmit buffer are queued.
+  * @param  Buffer: pointer to the data to transmit.
+  * @param  Length: number of bytes to transmit.
+  * @retval The number of bytes actually queued.
+  */
+uint8_t UART3_Write(const uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Write(&UART3_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Fetches the data received by UART3 from the receive buffer.
+  * @note   This function never waits: only the bytes already received
+  *         are returned.
+  * @param  Buffer: pointer to the destination buffer.
+  * @param  Length: maximum number of bytes to read.
+  * @retval The number of bytes actually read.
+  */
+uint8_t UART3_Read(uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Read(&UART3_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Returns the number of received bytes waiting in the receive buffer.
+  * @param  None
+  * @retval Number of bytes available to UART3_Read().
+  */
+uint8_t UART3_GetRxCount(void)
+{
+  return UART_GetRxCount(&UART3_Buffer);
+}
+
+/**
+  * @brief  Returns the free space left in the transmit buffer.
+  * @param  None
+  * @retval Number of bytes UART3_Write() can accept without truncation.
+  */
+uint8_t UART3_GetTxFree(void)
+{
+  return UART_GetTxFree(&UART3_Buffer);
+}
+
+/**
+  * @brief  Feeds the UART3 transmitter from the transmit buffer.
+  * @note   To be called from the UART3 TX interrupt routine. The transmitter
+  *         interrupt is disabled as soon as the last byte is loaded.
+  * @param  None
+  * @retval None
+  */
+void UART3_TxISR(void)
+{
+  UART_TxISR(&UART3_Buffer);
+}
+
+/**
+  * @brief  Stores the byte received by UART3 into the receive buffer.
+  * @note   To be called from the UART3 RX interrupt routine. The byte is
+  *         dropped when the receive buffer is full.
+  * @param  None
+  * @retval None
+  */
+void UART3_RxISR(void)
+{
+  UART_RxISR(&UART3_Buffer);
 }
+#endif /* UART_BUFFER_SUPPORT */
 
 /**
   * @}
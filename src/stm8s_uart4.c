@@ -33,8 +33,29 @@
   */
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+#if !IS_UART_BUFFER_SIZE_OK(UART4_TX_BUFFER_SIZE)
+ #error "UART4_TX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#if !IS_UART_BUFFER_SIZE_OK(UART4_RX_BUFFER_SIZE)
+ #error "UART4_RX_BUFFER_SIZE must be a power of two between 2 and 128"
+#endif
+#endif /* UART_BUFFER_SUPPORT */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined (UART_BUFFER_SUPPORT)
+static uint8_t UART4_TxBuffer[UART4_TX_BUFFER_SIZE];
+static uint8_t UART4_RxBuffer[UART4_RX_BUFFER_SIZE];
+static UART_Buffer_TypeDef UART4_Buffer =
+{
+  UART4_CORE,
+  UART4_TxBuffer,
+  UART4_RxBuffer,
+  (uint8_t)(UART4_TX_BUFFER_SIZE - 1),
+  (uint8_t)(UART4_RX_BUFFER_SIZE - 1),
+  0, 0, 0, 0
+};
+#endif /* UART_BUFFER_SUPPORT */
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 /* Public functions ----------------------------------------------------------*/
@@ -52,22 +73,13 @@
 
 void UART4_DeInit(void)
 {
-  /*  Clear the Idle Line Detected bit in the status register by a read
-  to the UART4_SR register followed by a Read to the UART4_DR register */
-  (void)UART4->SR;
-  (void)UART4->DR;
-  
-  UART4->BRR2 = UART4_BRR2_RESET_VALUE;  /*  Set UART4_BRR2 to reset value 0x00 */
-  UART4->BRR1 = UART4_BRR1_RESET_VALUE;  /*  Set UART4_BRR1 to reset value 0x00 */
+  UART_DeInit(UART4_CORE);
   
-  UART4->CR1 = UART4_CR1_RESET_VALUE; /*  Set UART4_CR1 to reset value 0x00  */
-  UART4->CR2 = UART4_CR2_RESET_VALUE; /*  Set UART4_CR2 to reset value 0x00  */
-  UART4->CR3 = UART4_CR3_RESET_VALUE; /*  Set UART4_CR3 to reset value 0x00  */
-  UART4->CR4 = UART4_CR4_RESET_VALUE; /*  Set UART4_CR4 to reset value 0x00  */
   UART4->CR5 = UART4_CR5_RESET_VALUE; /*  Set UART4_CR5 to reset value 0x00  */
   UART4->CR6 = UART4_CR6_RESET_VALUE; /*  Set UART4_CR6 to reset value 0x00  */
 }
 
+#if defined (UART_RUNTIME_BAUDRATE_SUPPORT)
 /**
   * @brief  Initializes the UART4 according to the specified parameters.
   * @param  BaudRate: The baudrate.
@@ -84,9 +96,6 @@ void UART4_DeInit(void)
   */
 void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode)
 {
-  uint8_t BRR2_1 = 0, BRR2_2 = 0;
-  uint32_t BaudRate_Mantissa = 0, BaudRate_Mantissa100 = 0;
-  
   /* Check the parameters */
   assert_param(IS_UART4_BAUDRATE_OK(BaudRate));
   assert_param(IS_UART4_WORDLENGTH_OK(WordLength));
@@ -95,81 +104,42 @@ void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, UART4_St
   assert_param(IS_UART4_MODE_OK((uint8_t)Mode));
   assert_param(IS_UART4_SYNCMODE_OK((uint8_t)SyncMode));
   
-  /* Clear the word length bit */
-  UART4->CR1 &= (uint8_t)(~UART4_CR1_M);
-  /* Set the word length bit according to UART4_WordLength value */
-  UART4->CR1 |= (uint8_t)WordLength; 
-  
-  /* Clear the STOP bits */
-  UART4->CR3 &= (uint8_t)(~UART4_CR3_STOP);
-  /* Set the STOP bits number according to UART4_StopBits value  */
-  UART4->CR3 |= (uint8_t)StopBits; 
-  
-  /* Clear the Parity Control bit */
-  UART4->CR1 &= (uint8_t)(~(UART4_CR1_PCEN | UART4_CR1_PS  ));
-  /* Set the Parity Control bit to UART4_Parity value */
-  UART4->CR1 |= (uint8_t)Parity;
-  
-  /* Clear the LSB mantissa of UART4DIV  */
-  UART4->BRR1 &= (uint8_t)(~UART4_BRR1_DIVM);
-  /* Clear the MSB mantissa of UART4DIV  */
-  UART4->BRR2 &= (uint8_t)(~UART4_BRR2_DIVM);
-  /* Clear the Fraction bits of UART4DIV */
-  UART4->BRR2 &= (uint8_t)(~UART4_BRR2_DIVF);
-  
-  /* Set the UART4 BaudRates in BRR1 and BRR2 registers according to UART4_BaudRate value */
-  BaudRate_Mantissa    = ((uint32_t)CLK_GetClockFreq() / (BaudRate << 4));
-  BaudRate_Mantissa100 = (((uint32_t)CLK_GetClockFreq() * 100) / (BaudRate << 4));
-  
-  /* The fraction and MSB mantissa should be loaded in one step in the BRR2 register*/
-  /* Set the fraction of UARTDIV  */
-  BRR2_1 = (uint8_t)((uint8_t)(((BaudRate_Mantissa100 - (BaudRate_Mantissa * 100))
-                                << 4) / 100) & (uint8_t)0x0F); 
-  BRR2_2 = (uint8_t)((BaudRate_Mantissa >> 4) & (uint8_t)0xF0);
-  
-  UART4->BRR2 = (uint8_t)(BRR2_1 | BRR2_2);
-  /* Set the LSB mantissa of UARTDIV  */
-  UART4->BRR1 = (uint8_t)BaudRate_Mantissa;           
-  
-  /* Disable the Transmitter and Receiver before setting the LBCL, CPOL and CPHA bits */
-  UART4->CR2 &= (uint8_t)~(UART4_CR2_TEN | UART4_CR2_REN);
-  /* Clear the Clock Polarity, lock Phase, Last Bit Clock pulse */
-  UART4->CR3 &= (uint8_t)~(UART4_CR3_CPOL | UART4_CR3_CPHA | UART4_CR3_LBCL);
-  /* Set the Clock Polarity, lock Phase, Last Bit Clock pulse */
-  UART4->CR3 |= (uint8_t)((uint8_t)SyncMode & (uint8_t)(UART4_CR3_CPOL | \
-    UART4_CR3_CPHA | UART4_CR3_LBCL));
+  UART_Init(UART4_CORE, BaudRate, (uint8_t)WordLength, (uint8_t)StopBits,
+            (uint8_t)Parity, (uint8_t)SyncMode, (uint8_t)Mode);
+}
+#endif /* UART_RUNTIME_BAUDRATE_SUPPORT */
+
+/**
+  * @brief  Initializes the UART4 with precomputed baud rate registers.
+  * @note   This function does not use CLK_GetClockFreq() nor any 32-bit
+  *         division: the register values are given by UART_BRR1_FROM() and
+  *         UART_BRR2_FROM(), or by UART4_BRR1_VALUE and UART4_BRR2_VALUE.
+  * @param  BRR1: BRR1 register value.
+  * @param  BRR2: BRR2 register value.
+  * @param  WordLength : This parameter can be any of the 
+  *         @ref UART4_WordLength_TypeDef enumeration.
+  * @param  StopBits: This parameter can be any of the 
+  *         @ref UART4_StopBits_TypeDef enumeration.
+  * @param  Parity: This parameter can be any of the 
+  *         @ref UART4_Parity_TypeDef enumeration.
+  * @param  SyncMode: This parameter can be any of the 
+  *         @ref UART4_SyncMode_TypeDef values.
+  * @param  Mode: This parameter can be any of the @ref UART4_Mode_TypeDef values
+  * @retval None
+  */
+void UART4_InitBRR(uint8_t BRR1, uint8_t BRR2, UART4_WordLength_TypeDef WordLength, 
+                   UART4_StopBits_TypeDef StopBits, UART4_Parity_TypeDef Parity, 
+                   UART4_SyncMode_TypeDef SyncMode, UART4_Mode_TypeDef Mode)
+{
+  /* Check the parameters */
+  assert_param(IS_UART4_WORDLENGTH_OK(WordLength));
+  assert_param(IS_UART4_STOPBITS_OK(StopBits));
+  assert_param(IS_UART4_PARITY_OK(Parity));
+  assert_param(IS_UART4_MODE_OK((uint8_t)Mode));
+  assert_param(IS_UART4_SYNCMODE_OK((uint8_t)SyncMode));
   
-  if((uint8_t)(Mode & UART4_MODE_TX_ENABLE))
-  {
-    /* Set the Transmitter Enable bit */
-    UART4->CR2 |= (uint8_t)UART4_CR2_TEN;
-  }
-  else
-  {
-    /* Clear the Transmitter Disable bit */
-    UART4->CR2 &= (uint8_t)(~UART4_CR2_TEN);
-  }
-  if((uint8_t)(Mode & UART4_MODE_RX_ENABLE))
-  {
-    /* Set the Receiver Enable bit */
-    UART4->CR2 |= (uint8_t)UART4_CR2_REN;
-  }
-  else
-  {
-    /* Clear the Receiver Disable bit */
-    UART4->CR2 &= (uint8_t)(~UART4_CR2_REN);
-  }
-  /* Set the Clock Enable bit, lock Polarity, lock Phase and Last Bit Clock 
-  pulse bits according to UART4_Mode value */
-  if((uint8_t)(SyncMode & UART4_SYNCMODE_CLOCK_DISABLE))
-  {
-    /* Clear the Clock Enable bit */
-    UART4->CR3 &= (uint8_t)(~UART4_CR3_CKEN); 
-  }
-  else
-  {
-    UART4->CR3 |= (uint8_t)((uint8_t)SyncMode & UART4_CR3_CKEN);
-  }
+  UART_InitBRR(UART4_CORE, BRR1, BRR2, (uint8_t)WordLength, (uint8_t)StopBits,
+               (uint8_t)Parity, (uint8_t)SyncMode, (uint8_t)Mode);
 }
 
 /**
@@ -180,16 +150,7 @@ void UART4_Init(uint32_t BaudRate, UART4_WordLength_TypeDef WordLength, UART4_St
   */
 void UART4_Cmd(FunctionalState NewState)
 {
-  if(NewState != DISABLE)
-  {
-    /* UART4 Enable */
-    UART4->CR1 &= (uint8_t)(~UART4_CR1_UARTD);
-  }
-  else
-  {
-    /* UART4 Disable */
-    UART4->CR1 |= UART4_CR1_UARTD; 
-  }
+  UART_Cmd(UART4_CORE, NewState);
 }
 
 /**
@@ -209,58 +170,11 @@ void UART4_Cmd(FunctionalState NewState)
   */
 void UART4_ITConfig(UART4_IT_TypeDef UART4_IT, FunctionalState NewState)
 {
-  uint8_t uartreg = 0, itpos = 0x00;
-  
   /* Check the parameters */
   assert_param(IS_UART4_CONFIG_IT_OK(UART4_IT));
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  /* Get the UART4 register index */
-  uartreg = (uint8_t)((uint16_t)UART4_IT >> 0x08);
-  
-  /* Get the UART4 IT index */
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART4_IT & (uint8_t)0x0F));
-  
-  if(NewState != DISABLE)
-  {
-    /* Enable the Interrupt bits according to UART4_IT mask */
-    if(uartreg == 0x01)
-    {
-      UART4->CR1 |= itpos;
-    }
-    else if(uartreg == 0x02)
-    {
-      UART4->CR2 |= itpos;
-    }
-    else if(uartreg == 0x03)
-    {
-      UART4->CR4 |= itpos;
-    }
-    else
-    {
-      UART4->CR6 |= itpos;
-    }
-  }
-  else
-  {
-    /* Disable the interrupt bits according to UART4_IT mask */
-    if(uartreg == 0x01)
-    {
-      UART4->CR1 &= (uint8_t)(~itpos);
-    }
-    else if(uartreg == 0x02)
-    {
-      UART4->CR2 &= (uint8_t)(~itpos);
-    }
-    else if(uartreg == 0x03)
-    {
-      UART4->CR4 &= (uint8_t)(~itpos);
-    }
-    else
-    {
-      UART4->CR6 &= (uint8_t)(~itpos);
-    }
-  }
+  UART_ITConfig(UART4_CORE, (uint16_t)UART4_IT, NewState);
 }
 
 /**
@@ -273,16 +187,10 @@ void UART4_HalfDuplexCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if (NewState != DISABLE)
-  {
-    UART4->CR5 |= UART4_CR5_HDSEL;  /**< UART4 Half Duplex Enable  */
-  }
-  else
-  {
-    UART4->CR5 &= (uint8_t)~UART4_CR5_HDSEL; /**< UART4 Half Duplex Disable */
-  }
+  UART_HalfDuplexCmd(UART4_CORE, NewState);
 }
 
+#if defined (UART_IRDA_SUPPORT)
 /**
   * @brief  Configures the UART4s IrDA interface.
   * @param  UART4_IrDAMode specifies the IrDA mode.
@@ -293,14 +201,7 @@ void UART4_IrDAConfig(UART4_IrDAMode_TypeDef UART4_IrDAMode)
 {
   assert_param(IS_UART4_IRDAMODE_OK(UART4_IrDAMode));
   
-  if(UART4_IrDAMode != UART4_IRDAMODE_NORMAL)
-  {
-    UART4->CR5 |= UART4_CR5_IRLP;
-  }
-  else
-  {
-    UART4->CR5 &= ((uint8_t)~UART4_CR5_IRLP);
-  }
+  UART_IrDAConfig(UART4_CORE, (uint8_t)UART4_IrDAMode);
 }
 
 /**
@@ -314,18 +215,11 @@ void UART4_IrDACmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if(NewState != DISABLE)
-  {
-    /* Enable the IrDA mode by setting the IREN bit in the CR3 register */
-    UART4->CR5 |= UART4_CR5_IREN;
-  }
-  else
-  {
-    /* Disable the IrDA mode by clearing the IREN bit in the CR3 register */
-    UART4->CR5 &= ((uint8_t)~UART4_CR5_IREN);
-  }
+  UART_IrDACmd(UART4_CORE, NewState);
 }
+#endif /* UART_IRDA_SUPPORT */
 
+#if defined (UART_LIN_SUPPORT)
 /**
   * @brief  Sets the UART4 LIN Break detection length.
   * @param  UART4_LINBreakDetectionLength specifies the LIN break detection length.
@@ -338,14 +232,7 @@ void UART4_LINBreakDetectionConfig(UART4_LINBreakDetectionLength_TypeDef UART4_L
   /* Check parameters */    
   assert_param(IS_UART4_LINBREAKDETECTIONLENGTH_OK(UART4_LINBreakDetectionLength));
   
-  if(UART4_LINBreakDetectionLength != UART4_LINBREAKDETECTIONLENGTH_10BITS)
-  {
-    UART4->CR4 |= UART4_CR4_LBDL;
-  }
-  else
-  {
-    UART4->CR4 &= ((uint8_t)~UART4_CR4_LBDL);
-  }
+  UART_LINBreakDetectionConfig(UART4_CORE, (uint8_t)UART4_LINBreakDetectionLength);
 }
 
 /**
@@ -367,32 +254,7 @@ void UART4_LINConfig(UART4_LinMode_TypeDef UART4_Mode,
   assert_param(IS_UART4_AUTOSYNC_OK(UART4_Autosync));
   assert_param(IS_UART4_DIVUP_OK(UART4_DivUp));
   
-  if(UART4_Mode != UART4_LIN_MODE_MASTER)
-  {
-    UART4->CR6 |=  UART4_CR6_LSLV;
-  }
-  else
-  {
-    UART4->CR6 &= ((uint8_t)~UART4_CR6_LSLV);
-  }
-  
-  if(UART4_Autosync != UART4_LIN_AUTOSYNC_DISABLE)
-  {
-    UART4->CR6 |=  UART4_CR6_LASE ;
-  }
-  else
-  {
-    UART4->CR6 &= ((uint8_t)~ UART4_CR6_LASE );
-  }
-  
-  if(UART4_DivUp != UART4_LIN_DIVUP_LBRR1)
-  {
-    UART4->CR6 |=  UART4_CR6_LDUM;
-  }
-  else
-  {
-    UART4->CR6 &= ((uint8_t)~ UART4_CR6_LDUM);
-  }
+  UART_LINConfig(UART4_CORE, (uint8_t)UART4_Mode, (uint8_t)UART4_Autosync, (uint8_t)UART4_DivUp);
 }
 
 /**
@@ -405,18 +267,11 @@ void UART4_LINCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if(NewState != DISABLE)
-  {
-    /* Enable the LIN mode by setting the LINE bit in the CR2 register */
-    UART4->CR3 |= UART4_CR3_LINEN;
-  }
-  else
-  {
-    /* Disable the LIN mode by clearing the LINE bit in the CR2 register */
-    UART4->CR3 &= ((uint8_t)~UART4_CR3_LINEN);
-  }
+  UART_LINCmd(UART4_CORE, NewState);
 }
+#endif /* UART_LIN_SUPPORT */
 
+#if defined (UART_SMARTCARD_SUPPORT)
 /**
   * @brief  Enables or disables the UART4 Smart Card mode.
   * @param  NewState: new state of the Smart Card mode.
@@ -428,16 +283,7 @@ void UART4_SmartCardCmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if(NewState != DISABLE)
-  {
-    /* Enable the SC mode by setting the SCEN bit in the CR5 register */
-    UART4->CR5 |= UART4_CR5_SCEN;
-  }
-  else
-  {
-    /* Disable the SC mode by clearing the SCEN bit in the CR5 register */
-    UART4->CR5 &= ((uint8_t)(~UART4_CR5_SCEN));
-  }
+  UART_SmartCardCmd(UART4_CORE, NewState);
 }
 
 /**
@@ -451,17 +297,9 @@ void UART4_SmartCardNACKCmd(FunctionalState NewState)
   /* Check parameters */
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if(NewState != DISABLE)
-  {
-    /* Enable the NACK transmission by setting the NACK bit in the CR5 register */
-    UART4->CR5 |= UART4_CR5_NACK;
-  }
-  else
-  {
-    /* Disable the NACK transmission by clearing the NACK bit in the CR5 register */
-    UART4->CR5 &= ((uint8_t)~(UART4_CR5_NACK));
-  }
+  UART_SmartCardNACKCmd(UART4_CORE, NewState);
 }
+#endif /* UART_SMARTCARD_SUPPORT */
 
 /**
   * @brief  Selects the UART4 WakeUp method.
@@ -473,8 +311,7 @@ void UART4_WakeUpConfig(UART4_WakeUp_TypeDef UART4_WakeUp)
 {
   assert_param(IS_UART4_WAKEUP_OK(UART4_WakeUp));
   
-  UART4->CR1 &= ((uint8_t)~UART4_CR1_WAKE);
-  UART4->CR1 |= (uint8_t)UART4_WakeUp;
+  UART_WakeUpConfig(UART4_CORE, (uint8_t)UART4_WakeUp);
 }
 
 /**
@@ -487,16 +324,7 @@ void UART4_ReceiverWakeUpCmd(FunctionalState NewState)
 {
   assert_param(IS_FUNCTIONALSTATE_OK(NewState));
   
-  if(NewState != DISABLE)
-  {
-    /* Enable the mute mode UART4 by setting the RWU bit in the CR2 register */
-    UART4->CR2 |= UART4_CR2_RWU;
-  }
-  else
-  {
-    /* Disable the mute mode UART4 by clearing the RWU bit in the CR1 register */
-    UART4->CR2 &= ((uint8_t)~UART4_CR2_RWU);
-  }
+  UART_ReceiverWakeUpCmd(UART4_CORE, NewState);
 }
 
 /**
@@ -516,11 +344,7 @@ uint8_t UART4_ReceiveData8(void)
   */
 uint16_t UART4_ReceiveData9(void)
 {
-  uint16_t temp = 0;
-  
-  temp = ((uint16_t)(((uint16_t)((uint16_t)UART4->CR1 & (uint16_t)UART4_CR1_R8)) << 1));
-  
-  return (uint16_t)((((uint16_t)UART4->DR) | temp) & ((uint16_t)0x01FF));
+  return UART_ReceiveData9(UART4_CORE);
 }
 
 /**
@@ -541,14 +365,7 @@ void UART4_SendData8(uint8_t Data)
   */
 void UART4_SendData9(uint16_t Data)
 {
-  /* Clear the transmit data bit 8 */
-  UART4->CR1 &= ((uint8_t)~UART4_CR1_T8);                  
-  
-  /* Write the transmit data bit [8] */
-  UART4->CR1 |= (uint8_t)(((uint8_t)(Data >> 2)) & UART4_CR1_T8); 
-  
-  /* Write the transmit data bit [0:7] */
-  UART4->DR   = (uint8_t)(Data);                    
+  UART_SendData9(UART4_CORE, Data);
 }
 
 /**
@@ -571,12 +388,10 @@ void UART4_SetAddress(uint8_t UART4_Address)
   /*assert_param for x UART4_Address*/
   assert_param(IS_UART4_ADDRESS_OK(UART4_Address));
   
-  /* Clear the UART4 address */
-  UART4->CR4 &= ((uint8_t)~UART4_CR4_ADD);
-  /* Set the UART4 address node */
-  UART4->CR4 |= UART4_Address;
+  UART_SetAddress(UART4_CORE, UART4_Address);
 }
 
+#if defined (UART_SMARTCARD_SUPPORT)
 /**
   * @brief  Sets the specified UART4 guard time.
   * @note   SmartCard Mode should be Enabled  
@@ -588,7 +403,9 @@ void UART4_SetGuardTime(uint8_t UART4_GuardTime)
   /* Set the UART4 guard time */
   UART4->GTR = UART4_GuardTime;
 }
+#endif /* UART_SMARTCARD_SUPPORT */
 
+#if defined (UART_SMARTCARD_SUPPORT) || defined (UART_IRDA_SUPPORT)
 /**
   * @brief  Sets the system clock prescaler.
   * @note   IrDA Low Power mode or smartcard mode should be enabled
@@ -616,6 +433,7 @@ void UART4_SetPrescaler(uint8_t UART4_Prescaler)
   /* Load the UART4 prescaler value*/
   UART4->PSCR = UART4_Prescaler;
 }
+#endif /* UART_SMARTCARD_SUPPORT || UART_IRDA_SUPPORT */
 
 /**
   * @brief  Checks whether the specified UART4 flag is set or not.
@@ -625,67 +443,11 @@ void UART4_SetPrescaler(uint8_t UART4_Prescaler)
   */
 FlagStatus UART4_GetFlagStatus(UART4_Flag_TypeDef UART4_FLAG)
 {
-  FlagStatus status = RESET;
-  
   /* Check parameters */
   assert_param(IS_UART4_FLAG_OK(UART4_FLAG));
   
-  /* Check the status of the specified UART4 flag*/
-  if(UART4_FLAG == UART4_FLAG_LBDF)
-  {
-    if((UART4->CR4 & (uint8_t)UART4_FLAG) != (uint8_t)0x00)
-    {
-      /* UART4_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART4_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if(UART4_FLAG == UART4_FLAG_SBK)
-  {
-    if((UART4->CR2 & (uint8_t)UART4_FLAG) != (uint8_t)0x00)
-    {
-      /* UART4_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART4_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else if((UART4_FLAG == UART4_FLAG_LHDF) || (UART4_FLAG == UART4_FLAG_LSF))
-  {
-    if((UART4->CR6 & (uint8_t)UART4_FLAG) != (uint8_t)0x00)
-    {
-      /* UART4_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART4_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  else
-  {
-    if((UART4->SR & (uint8_t)UART4_FLAG) != (uint8_t)0x00)
-    {
-      /* UART4_FLAG is set*/
-      status = SET;
-    }
-    else
-    {
-      /* UART4_FLAG is reset*/
-      status = RESET;
-    }
-  }
-  
   /* Return the UART4_FLAG status*/
-  return  status;
+  return UART_GetFlagStatus(UART4_CORE, (uint16_t)UART4_FLAG);
 }
 
 /**
@@ -720,26 +482,7 @@ void UART4_ClearFlag(UART4_Flag_TypeDef UART4_FLAG)
 {
   assert_param(IS_UART4_CLEAR_FLAG_OK(UART4_FLAG));
   
-  /*  Clear the Receive Register Not Empty flag */
-  if(UART4_FLAG == UART4_FLAG_RXNE)
-  {
-    UART4->SR = (uint8_t)~(UART4_SR_RXNE);
-  }
-  /*  Clear the LIN Break Detection flag */
-  else if(UART4_FLAG == UART4_FLAG_LBDF)
-  {
-    UART4->CR4 &= (uint8_t)(~UART4_CR4_LBDF);
-  }
-  /*  Clear the LIN Header Detection Flag */
-  else if(UART4_FLAG == UART4_FLAG_LHDF)
-  {
-    UART4->CR6 &= (uint8_t)(~UART4_CR6_LHDF);
-  }
-  /*  Clear the LIN Synch Field flag */
-  else
-  {
-    UART4->CR6 &= (uint8_t)(~UART4_CR6_LSF);
-  }
+  UART_ClearFlag(UART4_CORE, (uint16_t)UART4_FLAG);
 }
 
 /**
@@ -757,90 +500,11 @@ void UART4_ClearFlag(UART4_Flag_TypeDef UART4_FLAG)
   */
 ITStatus UART4_GetITStatus(UART4_IT_TypeDef UART4_IT)
 {
-  ITStatus pendingbitstatus = RESET;
-  uint8_t itpos = 0;
-  uint8_t itmask1 = 0;
-  uint8_t itmask2 = 0;
-  uint8_t enablestatus = 0;
-  
   /* Check parameters */
   assert_param(IS_UART4_GET_IT_OK(UART4_IT));
   
-  /* Get the UART4 IT index*/
-  itpos = (uint8_t)((uint8_t)1 << (uint8_t)((uint8_t)UART4_IT & (uint8_t)0x0F));
-  /* Get the UART4 IT index*/
-  itmask1 = (uint8_t)((uint8_t)UART4_IT >> (uint8_t)4);
-  /* Set the IT mask*/
-  itmask2 = (uint8_t)((uint8_t)1 << itmask1);
-  
-  /* Check the status of the specified UART4 pending bit*/
-  if(UART4_IT == UART4_IT_PE)
-  {
-    /* Get the UART4_ITPENDINGBIT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART4->CR1 & itmask2);
-    /* Check the status of the specified UART4 interrupt*/
-    
-    if(((UART4->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else if(UART4_IT == UART4_IT_LBDF)
-  {
-    /* Get the UART4_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART4->CR4 & itmask2);
-    /* Check the status of the specified UART4 interrupt*/
-    if(((UART4->CR4 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else if(UART4_IT == UART4_IT_LHDF)
-  {
-    /* Get the UART4_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART4->CR6 & itmask2);
-    /* Check the status of the specified UART4 interrupt*/
-    if(((UART4->CR6 & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
-  else
-  {
-    /* Get the UART4_IT enable bit status*/
-    enablestatus = (uint8_t)((uint8_t)UART4->CR2 & itmask2);
-    /* Check the status of the specified UART4 interrupt*/
-    if(((UART4->SR & itpos) != (uint8_t)0x00) && enablestatus)
-    {
-      /* Interrupt occurred*/
-      pendingbitstatus = SET;
-    }
-    else
-    {
-      /* Interrupt not occurred*/
-      pendingbitstatus = RESET;
-    }
-  }
   /* Return the UART4_IT status*/
-  return  pendingbitstatus;
+  return UART_GetITStatus(UART4_CORE, (uint16_t)UART4_IT);
 }
 
 /**
@@ -873,22 +537,99 @@ void UART4_ClearITPendingBit(UART4_IT_TypeDef UART4_IT)
 {
   assert_param(IS_UART4_CLEAR_IT_OK(UART4_IT));
   
-  /*  Clear the Receive Register Not Empty pending bit */
-  if(UART4_IT == UART4_IT_RXNE)
-  {
-    UART4->SR = (uint8_t)~(UART4_SR_RXNE);
-  }
-  /*  Clear the LIN Break Detection pending bit */
-  else if(UART4_IT == UART4_IT_LBDF)
-  {
-    UART4->CR4 &= (uint8_t)~(UART4_CR4_LBDF);
-  }
-  /*  Clear the LIN Header Detection pending bit */
-  else
-  {
-    UART4->CR6 &= (uint8_t)(~UART4_CR6_LHDF);
-  }
+  UART_ClearITPendingBit(UART4_CORE, (uint16_t)UART4_IT);
+}
+
+#if defined (UART_BUFFER_SUPPORT)
+/**
+  * @brief  Enables or disables the interrupt driven UART4 buffers.
+  * @note   Both ring buffers are flushed. When enabled, the receiver interrupt
+  *         is turned on so that incoming bytes are stored by UART4_RxISR();
+  *         the transmitter interrupt is turned on by UART4_Write() on demand.
+  * @note   UART4_TxISR() and UART4_RxISR() must be called from the UART4 TX
+  *         and RX interrupt routines and the buffers only carry 8-bit data.
+  * @note   The buffers are handled by the UART core, see UART_BufferCmd().
+  * @param  NewState: new state of the UART4 buffers.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void UART4_BufferCmd(FunctionalState NewState)
+{
+  assert_param(IS_FUNCTIONALSTATE_OK(NewState));
+  
+  UART_BufferCmd(&UART4_Buffer, NewState);
+}
+
+/**
+  * @brief  Queues data for interrupt driven transmission through UART4.
+  * @note   This function never waits: only the bytes that fit in the free
+  *         space of the transmit buffer are queued.
+  * @param  Buffer: pointer to the data to transmit.
+  * @param  Length: number of bytes to transmit.
+  * @retval The number of bytes actually queued.
+  */
+uint8_t UART4_Write(const uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Write(&UART4_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Fetches the data received by UART4 from the receive buffer.
+  * @note   This function never waits: only the bytes already received
+  *         are returned.
+  * @param  Buffer: pointer to the destination buffer.
+  * @param  Length: maximum number of bytes to read.
+  * @retval The number of bytes actually read.
+  */
+uint8_t UART4_Read(uint8_t* Buffer, uint8_t Length)
+{
+  return UART_Read(&UART4_Buffer, Buffer, Length);
+}
+
+/**
+  * @brief  Returns the number of received bytes waiting in the receive buffer.
+  * @param  None
+  * @retval Number of bytes available to UART4_Read().
+  */
+uint8_t UART4_GetRxCount(void)
+{
+  return UART_GetRxCount(&UART4_Buffer);
+}
+
+/**
+  * @brief  Returns the free space left in the transmit buffer.
+  * @param  None
+  * @retval Number of bytes UART4_Write() can accept without truncation.
+  */
+uint8_t UART4_GetTxFree(void)
+{
+  return UART_GetTxFree(&UART4_Buffer);
+}
+
+/**
+  * @brief  Feeds the UART4 transmitter from the transmit buffer.
+  * @note   To be called from the UART4 TX interrupt routine. The transmitter
+  *         interrupt is disabled as soon as the last byte is loaded.
+  * @param  None
+  * @retval None
+  */
+void UART4_TxISR(void)
+{
+  UART_TxISR(&UART4_Buffer);
+}
+
+/**
+  * @brief  Stores the byte received by UART4 into the receive buffer.
+  * @note   To be called from the UART4 RX interrupt routine. The byte is
+  *         dropped when the receive buffer is full.
+  * @param  None
+  * @retval None
+  */
+void UART4_RxISR(void)
+{
+  UART_RxISR(&UART4_Buffer);
 }
+#endif /* UART_BUFFER_SUPPORT */
 
 /**
   * @}
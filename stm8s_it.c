@@ -189,9 +189,9 @@ INTERRUPT_HANDLER(EXTI_PORTE_IRQHandler, 7)
   */
  INTERRUPT_HANDLER(CAN_RX_IRQHandler, 8)
  {
-  /* In order to detect unexpected events during development,
-     it is recommended to set a breakpoint on the following instruction.
-  */
+#if defined (CAN_RX_FIFO_SUPPORT)
+  CAN_RxISR();
+#endif /* CAN_RX_FIFO_SUPPORT */
  }
 
 /**
@@ -201,9 +201,13 @@ INTERRUPT_HANDLER(EXTI_PORTE_IRQHandler, 7)
   */
  INTERRUPT_HANDLER(CAN_TX_IRQHandler, 9)
  {
-  /* In order to detect unexpected events during development,
-     it is recommended to set a breakpoint on the following instruction.
-  */
+#if defined (CAN_STATISTICS_SUPPORT)
+  /* Before CAN_TxISR() which acknowledges all the completed requests */
+  CAN_StatisticsISR();
+#endif /* CAN_STATISTICS_SUPPORT */
+#if defined (CAN_TX_QUEUE_SUPPORT)
+  CAN_TxISR();
+#endif /* CAN_TX_QUEUE_SUPPORT */
  }
 #endif /* (STM8S208) || (STM8AF52Ax) */
 
@@ -214,9 +218,9 @@ INTERRUPT_HANDLER(EXTI_PORTE_IRQHandler, 7)
   */
 INTERRUPT_HANDLER(SPI_IRQHandler, 10)
 {
-  /* In order to detect unexpected events during development,
-     it is recommended to set a breakpoint on the following instruction.
-  */
+#if defined (SPI_TRANSFER_SUPPORT)
+  SPI_ISR();
+#endif /* SPI_TRANSFER_SUPPORT */
 }
 
 /**
@@ -330,9 +334,10 @@ INTERRUPT_HANDLER(TIM1_CAP_COM_IRQHandler, 12)
   */
  INTERRUPT_HANDLER(UART1_TX_IRQHandler, 17)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Load the next byte of the UART1 transmit buffer */
+    UART1_TxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 
 /**
@@ -342,9 +347,10 @@ INTERRUPT_HANDLER(TIM1_CAP_COM_IRQHandler, 12)
   */
  INTERRUPT_HANDLER(UART1_RX_IRQHandler, 18)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Store the received byte in the UART1 receive buffer */
+    UART1_RxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 #endif /* (STM8S208) || (STM8S207) || (STM8S103) || (STM8S903) || (STM8AF62Ax) || (STM8AF52Ax) */
 
@@ -356,9 +362,10 @@ INTERRUPT_HANDLER(TIM1_CAP_COM_IRQHandler, 12)
   */
  INTERRUPT_HANDLER(UART4_TX_IRQHandler, 17)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Load the next byte of the UART4 transmit buffer */
+    UART4_TxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 
 /**
@@ -368,9 +375,10 @@ INTERRUPT_HANDLER(TIM1_CAP_COM_IRQHandler, 12)
   */
  INTERRUPT_HANDLER(UART4_RX_IRQHandler, 18)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Store the received byte in the UART4 receive buffer */
+    UART4_RxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 #endif /* (STM8AF622x) */
 
@@ -381,9 +389,9 @@ INTERRUPT_HANDLER(TIM1_CAP_COM_IRQHandler, 12)
   */
 INTERRUPT_HANDLER(I2C_IRQHandler, 19)
 {
-  /* In order to detect unexpected events during development,
-     it is recommended to set a breakpoint on the following instruction.
-  */
+#if defined (I2C_TRANSFER_SUPPORT) || defined (I2C_SLAVE_SUPPORT)
+  I2C_ISR();
+#endif /* I2C_TRANSFER_SUPPORT || I2C_SLAVE_SUPPORT */
 }
 
 #if defined(STM8S105) || defined(STM8S005) ||  defined (STM8AF626x)
@@ -394,9 +402,10 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
  INTERRUPT_HANDLER(UART2_TX_IRQHandler, 20)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Load the next byte of the UART2 transmit buffer */
+    UART2_TxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 
 /**
@@ -406,9 +415,10 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
  INTERRUPT_HANDLER(UART2_RX_IRQHandler, 21)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Store the received byte in the UART2 receive buffer */
+    UART2_RxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 #endif /* (STM8S105) || (STM8AF626x) */
 
@@ -420,9 +430,10 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
  INTERRUPT_HANDLER(UART3_TX_IRQHandler, 20)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Load the next byte of the UART3 transmit buffer */
+    UART3_TxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 
 /**
@@ -432,9 +443,10 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
  INTERRUPT_HANDLER(UART3_RX_IRQHandler, 21)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (UART_BUFFER_SUPPORT)
+    /* Store the received byte in the UART3 receive buffer */
+    UART3_RxISR();
+#endif /* UART_BUFFER_SUPPORT */
  }
 #endif /* (STM8S208) || (STM8S207) || (STM8AF52Ax) || (STM8AF62Ax) */
 
@@ -446,9 +458,17 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
  INTERRUPT_HANDLER(ADC2_IRQHandler, 22)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (ADC2_BURST_SUPPORT)
+  /* Store the conversion of a burst */
+  ADC2_BurstISR();
+#endif /* ADC2_BURST_SUPPORT */
+#if defined (ADC2_FILTER_SUPPORT)
+  if ((ADC2->CSR & ADC2_CSR_EOC) != 0)
+  {
+    /* Run the filter pipeline on the conversion */
+    ADC2_FilterISR();
+  }
+#endif /* ADC2_FILTER_SUPPORT */
  }
 #else /* STM8S105 or STM8S103 or STM8S903 or STM8AF626x or STM8AF622x */
 /**
@@ -460,9 +480,27 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
  INTERRUPT_HANDLER(ADC1_IRQHandler, 22)
  {
-    /* In order to detect unexpected events during development,
-       it is recommended to set a breakpoint on the following instruction.
-    */
+#if defined (ADC1_EVENT_SUPPORT)
+  if ((ADC1->CSR & (ADC1_CSR_AWD | ADC1_CSR_AWDIE)) == (ADC1_CSR_AWD | ADC1_CSR_AWDIE))
+  {
+    /* Check the channels out of the analog watchdog window */
+    ADC1_EventISR();
+  }
+#endif /* ADC1_EVENT_SUPPORT */
+#if defined (ADC1_SCAN_SUPPORT)
+  if (((ADC1->CSR & ADC1_CSR_EOCIE) != 0) && ((ADC1->CR2 & ADC1_CR2_SCAN) != 0))
+  {
+    /* Copy the channels scanned in the ping-pong buffer */
+    ADC1_ScanISR();
+  }
+#endif /* ADC1_SCAN_SUPPORT */
+#if defined (ADC1_FILTER_SUPPORT)
+  if (((ADC1->CSR & ADC1_CSR_EOCIE) != 0) && ((ADC1->CR2 & ADC1_CR2_SCAN) == 0))
+  {
+    /* Run the filter pipeline on the conversion */
+    ADC1_FilterISR();
+  }
+#endif /* ADC1_FILTER_SUPPORT */
  }
 #endif /* (STM8S208) || (STM8S207) || (STM8AF52Ax) || (STM8AF62Ax) */
 
@@ -474,9 +512,10 @@ INTERRUPT_HANDLER(I2C_IRQHandler, 19)
   */
 INTERRUPT_HANDLER(TIM6_UPD_OVF_TRG_IRQHandler, 23)
  {
-  /* In order to detect unexpected events during development,
-     it is recommended to set a breakpoint on the following instruction.
-  */
+#if defined (TICK_SUPPORT)
+  /* Count the millisecond of the system tick */
+  TICK_ISR();
+#endif /* TICK_SUPPORT */
  }
 #else /* STM8S208 or STM8S207 or STM8S105 or STM8S103 or STM8AF52Ax or STM8AF62Ax or STM8AF626x */
 /**
@@ -486,9 +525,10 @@ INTERRUPT_HANDLER(TIM6_UPD_OVF_TRG_IRQHandler, 23)
   */
  INTERRUPT_HANDLER(TIM4_UPD_OVF_IRQHandler, 23)
  {
-  /* In order to detect unexpected events during development,
-     it is recommended to set a breakpoint on the following instruction.
-  */
+#if defined (TICK_SUPPORT)
+  /* Count the millisecond of the system tick */
+  TICK_ISR();
+#endif /* TICK_SUPPORT */
  }
 #endif /* (STM8S903) || (STM8AF622x)*/
 